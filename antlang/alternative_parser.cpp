@@ -4,7 +4,7 @@ namespace ant
 {
 
 ptrdiff_t
-get_longest_failure_offset(std::vector<token>::const_iterator position,
+get_longest_failure_offset(token_iterator position,
                            parser_failure const& failure)
 {
     ptrdiff_t result = std::distance(position, failure.position);
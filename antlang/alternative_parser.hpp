@@ -15,7 +15,7 @@ namespace ant
 {
 
 ptrdiff_t
-get_longest_failure_offset(std::vector<token>::const_iterator position,
+get_longest_failure_offset(token_iterator position,
                            parser_failure const& failure);
 
 template <typename... Ts>
@@ -29,8 +29,8 @@ struct parser<alternative<Ts...>>
     result_type
     recursive_sub_parse(
             std::index_sequence<>,
-            std::vector<token>::const_iterator pos,
-            std::vector<token>::const_iterator end) const
+            token_iterator pos,
+            token_iterator end) const
     {
         return parser_failure{"Failed to parse alternative", pos};
     }
@@ -39,8 +39,8 @@ struct parser<alternative<Ts...>>
     result_type
     recursive_sub_parse(
             std::index_sequence<I, Is...>,
-            std::vector<token>::const_iterator pos,
-            std::vector<token>::const_iterator end) const
+            token_iterator pos,
+            token_iterator end) const
     {
         const auto parser = make_parser<type_at_t<I, Ts...>>();
         auto result = parser.parse(pos, end);
@@ -75,8 +75,8 @@ struct parser<alternative<Ts...>>
     }
 
     result_type
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         auto result = recursive_sub_parse(std::make_index_sequence<sizeof...(Ts)>(), pos, end);
         if (is_failure(result))
@@ -2,8 +2,10 @@
 
 #include "fundamental_types.hpp"
 #include "tokens.hpp"
+#include "token_stream.hpp"
 #include "recursive_variant.hpp"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,13 @@ get_context(recursive_wrapper<T> const& x)
     return get_context(static_cast<T const&>(x));
 }
 
+template <typename T>
+token_context
+get_context(cow_wrapper<T> const& x)
+{
+    return get_context(static_cast<T const&>(x));
+}
+
 template <typename... Ts>
 token_context
 get_context(recursive_variant<Ts...> const& v)
@@ -102,14 +111,14 @@ struct evaluation
 struct condition
 {
     std::vector<branch> branches;
-    recursive_wrapper<expression> fallback;
+    cow_wrapper<expression> fallback;
     token_context context;
 };
 
 struct scope
 {
     std::vector<binding> bindings;
-    recursive_wrapper<expression> value;
+    cow_wrapper<expression> value;
     token_context context;
 };
 
@@ -133,6 +142,9 @@ struct function
     std::vector<parameter> parameters;
     expression body;
     token_context context;
+    // Tokens of the body when it is parsed on the first call of the
+    // function instead, see parse_lazily.
+    std::optional<token_span> deferred_body;
 };
 
 struct structure
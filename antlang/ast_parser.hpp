@@ -53,8 +53,8 @@ struct parser<ast_rule<Attribute>>
     using attribute_type = attribute_of_t<ast_rule<Attribute>>;
 
     parser_result<attribute_type>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         const auto parser = make_parser<ast_rule<Attribute>>();
         auto result = parser.parse(pos, end);
@@ -64,7 +64,7 @@ struct parser<ast_rule<Attribute>>
             attribute_type converted = convert<attribute_type>(std::move(value));
             if constexpr (has_context<Attribute>())
             {
-                converted.context = pos->context;
+                converted.context = pos->context();
             }
             return parser_success<attribute_type>{std::move(converted), next};
         }
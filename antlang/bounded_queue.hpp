@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace ant
+{
+
+// A queue between the threads of a pipeline, holding at most capacity
+// values so that a fast producer waits for its consumer instead of
+// buffering its whole output. Closing the queue ends the pipeline: pushes
+// fail and pops return the values left, then nothing.
+template <typename T>
+class bounded_queue
+{
+public:
+    explicit bounded_queue(size_t capacity)
+        : capacity{capacity > 0 ? capacity : 1}
+    {
+    }
+
+    // Waits for room for the value, returns false when the queue is closed.
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return closed || values.size() < capacity; });
+        if (closed)
+        {
+            return false;
+        }
+        values.push_back(std::move(value));
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Waits for a value, returns nothing once the queue is closed and empty.
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return closed || !values.empty(); });
+        if (values.empty())
+        {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(values.front()));
+        values.pop_front();
+        not_full.notify_one();
+        return value;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+private:
+    const size_t capacity;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<T> values;
+    bool closed = false;
+};
+
+} // namespace ant
@@ -0,0 +1,43 @@
+#include "branch_profile.hpp"
+
+#include <iomanip>
+
+namespace ant
+{
+
+std::string profile_key(std::string const& name,
+                        std::vector<std::string> const& signature)
+{
+    std::string key = name + "(";
+    for (size_t i = 0; i < signature.size(); ++i)
+    {
+        key += (i == 0 ? "" : " ") + signature.at(i);
+    }
+    return key + ")";
+}
+
+void print_report(std::ostream& out, branch_profile const& profile)
+{
+    uint64_t total_before = 0;
+    uint64_t total_after = 0;
+    for (auto const& entry : profile.reorderings)
+    {
+        total_before += entry.checks_before;
+        total_after += entry.checks_after;
+        const double executions = entry.executions;
+        out << entry.function << " condition " << entry.condition << ": "
+            << std::fixed << std::setprecision(2)
+            << entry.checks_before / executions << " -> "
+            << entry.checks_after / executions << " checks per execution over "
+            << entry.executions << " executions\n";
+    }
+    if (total_before > 0)
+    {
+        out << "Reordered " << profile.reorderings.size() << " conditions, predicted "
+            << total_before - total_after << " fewer branch checks ("
+            << std::fixed << std::setprecision(1)
+            << 100.0 * (total_before - total_after) / total_before << "%)\n";
+    }
+}
+
+}  // namespace ant
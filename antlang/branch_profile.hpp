@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+
+// Hit counts of every branch of a condition, followed by its fallback.
+using branch_hits = std::vector<uint64_t>;
+
+// Predicted effect of reordering the branches of a profiled condition.
+struct branch_reordering
+{
+    std::string function;
+    size_t condition;
+    uint64_t executions;
+    uint64_t checks_before;
+    uint64_t checks_after;
+};
+
+// Branch hit counts of a training run, keyed by function and by the order
+// in which the conditions of the function are lowered.
+struct branch_profile
+{
+    std::map<std::string, std::vector<branch_hits>> functions;
+    std::vector<branch_reordering> reorderings;
+};
+
+// Key of a function in profiles, e.g. "fib(i32)".
+std::string profile_key(std::string const& name,
+                        std::vector<std::string> const& signature);
+
+void print_report(std::ostream& out, branch_profile const& profile);
+
+}  // namespace ant
@@ -0,0 +1,323 @@
+#include "passes.hpp"
+
+#include <limits>
+#include <numeric>
+#include <optional>
+
+namespace ant
+{
+
+namespace
+{
+
+bool is_constant_check(ir::expression const& check, bool value)
+{
+    return holds<ir::constant>(check) && get<bool>(get<ir::constant>(check).value) == value;
+}
+
+struct dead_branch_eliminator
+{
+    void operator()(ir::expression& expr) const
+    {
+        if (holds<ir::call>(expr))
+        {
+            for (auto& arg : get<ir::call>(expr).arguments)
+            {
+                (*this)(arg);
+            }
+        }
+        else if (holds<ir::scope>(expr))
+        {
+            auto& let = get<ir::scope>(expr);
+            for (auto& binding : let.bindings)
+            {
+                (*this)(binding.value);
+            }
+            (*this)(let.value.get());
+        }
+        else if (holds<ir::condition>(expr))
+        {
+            auto& cond = get<ir::condition>(expr);
+            std::vector<ir::branch> branches;
+            for (auto& branch : cond.branches)
+            {
+                (*this)(branch.check);
+                (*this)(branch.value);
+                if (is_constant_check(branch.check, false))
+                {
+                    continue;
+                }
+                if (is_constant_check(branch.check, true))
+                {
+                    // later branches are unreachable
+                    cond.fallback = std::move(branch.value);
+                    break;
+                }
+                branches.push_back(std::move(branch));
+            }
+            cond.branches = std::move(branches);
+            (*this)(cond.fallback.get());
+            if (cond.branches.empty())
+            {
+                ir::expression fallback = std::move(cond.fallback.get());
+                expr = std::move(fallback);
+            }
+        }
+    }
+};
+
+// Values of a parameter or local for which a comparison with a constant
+// holds, used to prove that the checks of a condition are exclusive.
+struct interval
+{
+    long double lower = -std::numeric_limits<long double>::infinity();
+    long double upper = std::numeric_limits<long double>::infinity();
+    bool lower_closed = false;
+    bool upper_closed = false;
+};
+
+struct comparison
+{
+    // parameter slot or local id
+    std::pair<void const*, size_t> subject;
+    interval values;
+};
+
+struct numeric_value
+{
+    std::optional<long double> operator()(bool) const
+    {
+        return std::nullopt;
+    }
+
+    std::optional<long double> operator()(runtime::structure const&) const
+    {
+        return std::nullopt;
+    }
+
+    template <typename T>
+    std::optional<long double> operator()(T x) const
+    {
+        return static_cast<long double>(x);
+    }
+};
+
+std::optional<std::pair<void const*, size_t>> subject_of(ir::expression const& expr)
+{
+    if (holds<ir::parameter>(expr))
+    {
+        return std::make_pair(static_cast<void const*>(get<ir::parameter>(expr).slot), size_t{0});
+    }
+    if (holds<ir::local>(expr))
+    {
+        return std::make_pair(static_cast<void const*>(nullptr), get<ir::local>(expr).id);
+    }
+    return std::nullopt;
+}
+
+std::optional<comparison> comparison_of(ir::expression const& check)
+{
+    if (!holds<ir::call>(check))
+    {
+        return std::nullopt;
+    }
+    auto const& call = get<ir::call>(check);
+    if (!ir::is_operation(call))
+    {
+        return std::nullopt;
+    }
+    std::string op = call.function;
+    auto const& lhs = call.arguments.at(0);
+    auto const& rhs = call.arguments.at(1);
+    auto subject = subject_of(lhs);
+    ir::expression const* bound = &rhs;
+    if (!subject)
+    {
+        // mirror (op c x) into (op' x c)
+        subject = subject_of(rhs);
+        bound = &lhs;
+        static const std::map<std::string, std::string> mirrored = {
+            {"=", "="}, {"<", ">"}, {"<=", ">="}, {">", "<"}, {">=", "<="}
+        };
+        auto it = mirrored.find(op);
+        op = it != mirrored.end() ? it->second : "";
+    }
+    if (!subject || !holds<ir::constant>(*bound))
+    {
+        return std::nullopt;
+    }
+    const auto value = visit(numeric_value{}, get<ir::constant>(*bound).value);
+    if (!value || *value != *value)
+    {
+        return std::nullopt;
+    }
+    comparison result{*subject, {}};
+    auto& values = result.values;
+    if (op == "=")
+    {
+        values = {*value, *value, true, true};
+    }
+    else if (op == "<" || op == "<=")
+    {
+        values.upper = *value;
+        values.upper_closed = op == "<=";
+    }
+    else if (op == ">" || op == ">=")
+    {
+        values.lower = *value;
+        values.lower_closed = op == ">=";
+    }
+    else
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool is_below(interval const& a, interval const& b)
+{
+    return a.upper < b.lower || (a.upper == b.lower && !(a.upper_closed && b.lower_closed));
+}
+
+// Branches may only be reordered when at most one of their checks holds.
+bool are_exclusive(std::vector<ir::branch> const& branches)
+{
+    std::vector<comparison> comparisons;
+    for (auto const& branch : branches)
+    {
+        auto result = comparison_of(branch.check);
+        if (!result)
+        {
+            return false;
+        }
+        comparisons.push_back(*result);
+    }
+    for (size_t i = 0; i < comparisons.size(); ++i)
+    {
+        for (size_t j = i + 1; j < comparisons.size(); ++j)
+        {
+            auto const& a = comparisons.at(i);
+            auto const& b = comparisons.at(j);
+            if (a.subject != b.subject ||
+                !(is_below(a.values, b.values) || is_below(b.values, a.values)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Number of checks evaluated for the given hits with the branches in order.
+uint64_t count_checks(branch_hits const& hits, std::vector<size_t> const& order)
+{
+    uint64_t checks = hits.back() * order.size();
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        checks += hits.at(order.at(position)) * (position + 1);
+    }
+    return checks;
+}
+
+// Visits the conditions in the order they are lowered, which is the order
+// their hits are recorded in.
+struct branch_reorderer
+{
+    branch_profile& profile;
+    std::string const& function;
+    std::vector<branch_hits> const& counts;
+    size_t next = 0;
+
+    void reorder(ir::condition& cond, size_t index)
+    {
+        if (index >= counts.size() || counts.at(index).size() != cond.branches.size() + 1)
+        {
+            return;
+        }
+        auto const& hits = counts.at(index);
+        const uint64_t executions = std::accumulate(hits.begin(), hits.end(), uint64_t{0});
+        if (executions == 0 || cond.branches.size() < 2 || !are_exclusive(cond.branches))
+        {
+            return;
+        }
+        std::vector<size_t> order(cond.branches.size());
+        std::iota(order.begin(), order.end(), 0);
+        const std::vector<size_t> source_order = order;
+        std::stable_sort(order.begin(), order.end(),
+                         [&hits](size_t lhs, size_t rhs) { return hits.at(lhs) > hits.at(rhs); });
+        if (order == source_order)
+        {
+            return;
+        }
+        std::vector<ir::branch> branches;
+        branches.reserve(order.size());
+        for (size_t i : order)
+        {
+            branches.push_back(std::move(cond.branches.at(i)));
+        }
+        cond.branches = std::move(branches);
+        profile.reorderings.push_back({
+            function,
+            index,
+            executions,
+            count_checks(hits, source_order),
+            count_checks(hits, order)
+        });
+    }
+
+    void operator()(ir::expression& expr)
+    {
+        if (holds<ir::call>(expr))
+        {
+            for (auto& arg : get<ir::call>(expr).arguments)
+            {
+                (*this)(arg);
+            }
+        }
+        else if (holds<ir::scope>(expr))
+        {
+            auto& let = get<ir::scope>(expr);
+            for (auto& binding : let.bindings)
+            {
+                (*this)(binding.value);
+            }
+            (*this)(let.value.get());
+        }
+        else if (holds<ir::condition>(expr))
+        {
+            auto& cond = get<ir::condition>(expr);
+            const size_t index = next++;
+            for (auto& [check, value] : cond.branches)
+            {
+                (*this)(check);
+                (*this)(value);
+            }
+            (*this)(cond.fallback.get());
+            reorder(cond, index);
+        }
+    }
+};
+
+}  // namespace
+
+void eliminate_dead_branches(compiler_environment const&, ir::function& func)
+{
+    dead_branch_eliminator{}(func.body);
+}
+
+void reorder_branches(compiler_environment const& env, ir::function& func)
+{
+    if (!env.profile || !func.pointer)
+    {
+        return;
+    }
+    const std::string key = profile_key(func);
+    auto it = env.profile->functions.find(key);
+    if (it == env.profile->functions.end())
+    {
+        return;
+    }
+    branch_reorderer{*env.profile, key, it->second}(func.body);
+}
+
+}  // namespace ant
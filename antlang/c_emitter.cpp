@@ -0,0 +1,565 @@
+#include "c_emitter.hpp"
+
+#include "formatting.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <sstream>
+#include <utility>
+
+namespace ant
+{
+
+namespace
+{
+
+const std::map<std::string, std::string> c_types = {
+    {"bool", "bool"},
+    {"i8",   "int8_t"},
+    {"i16",  "int16_t"},
+    {"i32",  "int32_t"},
+    {"i64",  "int64_t"},
+    {"u8",   "uint8_t"},
+    {"u16",  "uint16_t"},
+    {"u32",  "uint32_t"},
+    {"u64",  "uint64_t"},
+    {"f32",  "float"},
+    {"f64",  "double"},
+};
+
+const std::map<std::string, std::string> c_operators = {
+    {"+",  "+"},
+    {"-",  "-"},
+    {"*",  "*"},
+    {"=",  "=="},
+    {"!=", "!="},
+    {">",  ">"},
+    {"<",  "<"},
+    {">=", ">="},
+    {"<=", "<="},
+};
+
+constexpr auto prelude = R"(#include <math.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static jmp_buf ant_error_jump;
+
+#define ANT_DIVIDES(T, NAME) \
+    static T ant_divides_##NAME(T numerator, T denominator) \
+    { \
+        if (denominator == (T)0) \
+        { \
+            longjmp(ant_error_jump, 1); \
+        } \
+        return (T)(numerator / denominator); \
+    }
+
+ANT_DIVIDES(int8_t, i8)
+ANT_DIVIDES(int16_t, i16)
+ANT_DIVIDES(int32_t, i32)
+ANT_DIVIDES(int64_t, i64)
+ANT_DIVIDES(uint8_t, u8)
+ANT_DIVIDES(uint16_t, u16)
+ANT_DIVIDES(uint32_t, u32)
+ANT_DIVIDES(uint64_t, u64)
+ANT_DIVIDES(float, f32)
+ANT_DIVIDES(double, f64)
+
+)";
+
+compiler_failure unsupported(std::string const& what, token_context context)
+{
+    std::stringstream message;
+    message << "The C backend does not support " << what;
+    return compiler_failure{message.str(), context};
+}
+
+struct c_literal
+{
+    std::string operator()(ast::literal<bool> const& x) const
+    {
+        return x.value ? "true" : "false";
+    }
+
+    template <typename T>
+    std::string operator()(ast::literal<T> const& x) const
+    {
+        const std::string type = c_types.at(ast::name_of_v<ast::literal<T>>);
+        std::stringstream result;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isnan(x.value))
+            {
+                result << "((" << type << ")NAN)";
+            }
+            else if (std::isinf(x.value))
+            {
+                result << "((" << type << ")" << (x.value < 0 ? "-" : "") << "INFINITY)";
+            }
+            else
+            {
+                // hexadecimal floating point literals are exact
+                result << "((" << type << ")" << std::hexfloat << static_cast<double>(x.value) << ")";
+            }
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            if (x.value == std::numeric_limits<T>::min())
+            {
+                result << "((" << type << ")(" << (static_cast<long long>(x.value) + 1) << "LL - 1))";
+            }
+            else
+            {
+                result << "((" << type << ")" << static_cast<long long>(x.value) << "LL)";
+            }
+        }
+        else
+        {
+            result << "((" << type << ")" << static_cast<unsigned long long>(x.value) << "ULL)";
+        }
+        return result.str();
+    }
+};
+
+struct c_function
+{
+    std::string name;
+    std::string return_type;
+    std::vector<std::string> parameter_types;
+};
+
+using c_function_table = std::map<runtime::function const*, c_function>;
+
+// Emits the statements computing an expression into numbered temporaries.
+// Calls to the function being emitted assign the parameters one argument at
+// a time and restore them afterwards, mirroring the runtime which evaluates
+// arguments directly into the shared parameter slots of the callee.
+class c_function_emitter
+{
+public:
+    c_function_emitter(compiler_environment const& env,
+                       c_function_table const& functions,
+                       runtime::function const* self,
+                       std::ostream& out)
+        : env{env}
+        , functions{functions}
+        , self{self}
+        , out{&out}
+    {
+    }
+
+    void add_parameter(std::string const& name, std::string const& type)
+    {
+        std::string variable = "p" + std::to_string(parameters.size());
+        parameters.push_back({variable, type});
+        scope[name] = {variable, type};
+    }
+
+    compiler_expect<std::string> emit(ast::expression const& expr)
+    {
+        return visit([this](auto const& x) { return emit(x); }, expr);
+    }
+
+    compiler_expect<std::string> emit(ast::evaluation const& eval)
+    {
+        std::vector<std::string> signature;
+        std::vector<std::string> arguments;
+        std::vector<std::string> statements;
+        depth += 1;
+        for (auto const& arg : eval.arguments)
+        {
+            std::stringstream buffer;
+            auto compiled = capture(buffer, [&] { return emit(arg); });
+            if (is_failure(compiled))
+            {
+                return std::move(get_failure(compiled));
+            }
+            auto const& [variable, type] = get_success(compiled);
+            arguments.push_back(variable);
+            signature.push_back(type);
+            statements.push_back(buffer.str());
+        }
+        depth -= 1;
+
+        auto query = find_function(env, eval.function, signature);
+        if (is_failure(query))
+        {
+            std::stringstream message;
+            message << "Could not find function " << quote(eval.function);
+            return compiler_failure{message.str(), eval.context};
+        }
+        auto const& [return_type, func, inlining] = get_success(query);
+        if (!is_fundamental(return_type))
+        {
+            return unsupported("structures", eval.context);
+        }
+        const bool is_operation = holds<runtime::operation>(func->value);
+        auto it = functions.find(func);
+        if (!is_operation && it == functions.end())
+        {
+            return unsupported("structures", eval.context);
+        }
+
+        const std::string result = declare(return_type);
+        line() << "{\n";
+        depth += 1;
+        if (func == self)
+        {
+            for (size_t i = 0; i < parameters.size(); ++i)
+            {
+                auto const& [variable, type] = parameters.at(i);
+                line() << c_types.at(type) << " s" << i << " = " << variable << ";\n";
+            }
+        }
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            *out << statements.at(i);
+            if (func == self)
+            {
+                line() << parameters.at(i).variable << " = " << arguments.at(i) << ";\n";
+                arguments.at(i) = parameters.at(i).variable;
+            }
+        }
+        if (is_operation && eval.function == "/")
+        {
+            line() << result << " = ant_divides_" << signature.at(0) << "("
+                   << arguments.at(0) << ", " << arguments.at(1) << ");\n";
+        }
+        else if (is_operation)
+        {
+            line() << result << " = (" << c_types.at(return_type) << ")("
+                   << arguments.at(0) << ' ' << c_operators.at(eval.function) << ' '
+                   << arguments.at(1) << ");\n";
+        }
+        else
+        {
+            line() << result << " = " << it->second.name << "(";
+            for (size_t i = 0; i < arguments.size(); ++i)
+            {
+                *out << (i > 0 ? ", " : "") << arguments.at(i);
+            }
+            *out << ");\n";
+        }
+        if (func == self)
+        {
+            for (size_t i = 0; i < parameters.size(); ++i)
+            {
+                line() << parameters.at(i).variable << " = s" << i << ";\n";
+            }
+        }
+        depth -= 1;
+        line() << "}\n";
+        return compiler_result<std::string>{result, return_type};
+    }
+
+private:
+    struct c_variable
+    {
+        std::string variable;
+        std::string type;
+    };
+
+    static bool is_fundamental(std::string const& type)
+    {
+        return c_types.find(type) != c_types.end();
+    }
+
+    template <typename Emit>
+    std::invoke_result_t<Emit> capture(std::ostream& buffer, Emit emit)
+    {
+        std::ostream* previous = std::exchange(out, &buffer);
+        auto result = emit();
+        out = previous;
+        return result;
+    }
+
+    std::ostream& line()
+    {
+        return *out << std::string(4 * depth, ' ');
+    }
+
+    std::string declare(std::string const& type)
+    {
+        std::string variable = "t" + std::to_string(temporaries++);
+        line() << c_types.at(type) << ' ' << variable << ";\n";
+        return variable;
+    }
+
+    compiler_expect<std::string> emit(ast::reference const& ref)
+    {
+        auto it = scope.find(ref.name);
+        if (it == scope.end())
+        {
+            std::stringstream message;
+            message << "Undefined reference to " << quote(ref.name);
+            return compiler_failure{message.str(), ref.context};
+        }
+        auto const& [variable, type] = it->second;
+        if (!is_fundamental(type))
+        {
+            return unsupported("structures", ref.context);
+        }
+        // copy the value, since parameters are reassigned by recursive calls
+        std::string result = declare(type);
+        line() << result << " = " << variable << ";\n";
+        return compiler_result<std::string>{result, type};
+    }
+
+    compiler_expect<std::string> emit(ast::literal_variant const& literal)
+    {
+        const std::string type = visit(
+            [](auto const& x) -> std::string { return ast::name_of_v<std::decay_t<decltype(x)>>; },
+            literal);
+        std::string result = declare(type);
+        line() << result << " = " << visit(c_literal(), literal) << ";\n";
+        return compiler_result<std::string>{result, type};
+    }
+
+    compiler_expect<std::string> emit(ast::condition const& cond)
+    {
+        // the result type is only known after emitting a branch value
+        std::stringstream buffer;
+        const std::string result = "t" + std::to_string(temporaries++);
+        std::string result_type;
+        auto assign = [&](ast::expression const& expr) -> std::optional<compiler_failure>
+        {
+            auto value = emit(expr);
+            if (is_failure(value))
+            {
+                return std::move(get_failure(value));
+            }
+            result_type = get_success(value).type;
+            line() << result << " = " << get_success(value).value << ";\n";
+            return std::nullopt;
+        };
+        auto error = capture(buffer, [&]() -> std::optional<compiler_failure>
+        {
+            for (auto const& branch : cond.branches)
+            {
+                auto check = emit(branch.check);
+                if (is_failure(check))
+                {
+                    return std::move(get_failure(check));
+                }
+                line() << "if (" << get_success(check).value << ")\n";
+                line() << "{\n";
+                depth += 1;
+                if (auto failure = assign(branch.value))
+                {
+                    return std::move(*failure);
+                }
+                depth -= 1;
+                line() << "}\n";
+                line() << "else\n";
+                line() << "{\n";
+                depth += 1;
+            }
+            if (auto failure = assign(cond.fallback.get()))
+            {
+                return std::move(*failure);
+            }
+            for (size_t i = 0; i < cond.branches.size(); ++i)
+            {
+                depth -= 1;
+                line() << "}\n";
+            }
+            return std::nullopt;
+        });
+        if (error)
+        {
+            return std::move(*error);
+        }
+        line() << c_types.at(result_type) << ' ' << result << ";\n";
+        *out << buffer.str();
+        return compiler_result<std::string>{result, result_type};
+    }
+
+    compiler_expect<std::string> emit(ast::scope const& let)
+    {
+        std::stringstream buffer;
+        const std::string result = "t" + std::to_string(temporaries++);
+        const auto outer = scope;
+        depth += 1;
+        auto value = capture(buffer, [&]() -> compiler_expect<std::string>
+        {
+            for (auto const& binding : let.bindings)
+            {
+                auto value = emit(binding.value);
+                if (is_failure(value))
+                {
+                    return std::move(get_failure(value));
+                }
+                auto const& [variable, type] = get_success(value);
+                scope[binding.name] = {variable, type};
+            }
+            return emit(let.value.get());
+        });
+        depth -= 1;
+        scope = outer;
+        if (is_failure(value))
+        {
+            return std::move(get_failure(value));
+        }
+        auto const& [variable, type] = get_success(value);
+        line() << c_types.at(type) << ' ' << result << ";\n";
+        line() << "{\n";
+        *out << buffer.str();
+        line() << "    " << result << " = " << variable << ";\n";
+        line() << "}\n";
+        return compiler_result<std::string>{result, type};
+    }
+
+    compiler_environment const& env;
+    c_function_table const& functions;
+    runtime::function const* self;
+    std::ostream* out;
+    std::vector<c_variable> parameters;
+    std::map<std::string, c_variable> scope;
+    size_t temporaries = 0;
+    int depth = 1;
+};
+
+std::string mangle(std::string const& name, size_t index)
+{
+    std::stringstream result;
+    result << "ant_f" << index << '_';
+    for (char c : name)
+    {
+        result << (std::isalnum(static_cast<unsigned char>(c)) ? c : '_');
+    }
+    return result.str();
+}
+
+void declare_function(std::ostream& out, c_function const& func)
+{
+    out << "static " << c_types.at(func.return_type) << ' ' << func.name << '(';
+    for (size_t i = 0; i < func.parameter_types.size(); ++i)
+    {
+        out << (i > 0 ? ", " : "") << c_types.at(func.parameter_types.at(i)) << " p" << i;
+    }
+    if (func.parameter_types.empty())
+    {
+        out << "void";
+    }
+    out << ')';
+}
+
+} // namespace
+
+exceptional<std::string, compiler_failure>
+emit_c(compiler_environment const& env, ast::program const& program)
+{
+    c_function_table functions;
+    std::vector<ast::function const*> definitions;
+    std::vector<c_function> signatures;
+    std::vector<ast::evaluation const*> evaluations;
+
+    for (auto const& statement : program.statements)
+    {
+        if (holds<ast::structure>(statement))
+        {
+            return unsupported("structures", get<ast::structure>(statement).context);
+        }
+        if (holds<ast::evaluation>(statement))
+        {
+            evaluations.push_back(&get<ast::evaluation>(statement));
+            continue;
+        }
+        auto const& func = get<ast::function>(statement);
+        c_function signature{mangle(func.name, definitions.size()), func.return_type.name, {}};
+        for (auto const& param : func.parameters)
+        {
+            if (c_types.find(param.type) == c_types.end())
+            {
+                return unsupported("structures", param.context);
+            }
+            signature.parameter_types.push_back(param.type);
+        }
+        if (c_types.find(signature.return_type) == c_types.end())
+        {
+            return unsupported("structures", func.return_type.context);
+        }
+        auto query = find_function(env, func.name, signature.parameter_types);
+        if (is_failure(query))
+        {
+            std::stringstream message;
+            message << "Function " << quote(func.name) << " has not been compiled";
+            return compiler_failure{message.str(), func.context};
+        }
+        functions[get_success(query).function] = signature;
+        definitions.push_back(&func);
+        signatures.push_back(std::move(signature));
+    }
+
+    std::stringstream out;
+    out << prelude;
+
+    for (auto const& signature : signatures)
+    {
+        declare_function(out, signature);
+        out << ";\n";
+    }
+    out << '\n';
+
+    for (size_t i = 0; i < definitions.size(); ++i)
+    {
+        auto const& func = *definitions.at(i);
+        auto const& signature = signatures.at(i);
+        auto query = find_function(env, func.name, signature.parameter_types);
+        c_function_emitter emitter(env, functions, get_success(query).function, out);
+        for (size_t j = 0; j < func.parameters.size(); ++j)
+        {
+            emitter.add_parameter(func.parameters.at(j).name, func.parameters.at(j).type);
+        }
+        declare_function(out, signature);
+        out << "\n{\n";
+        auto result = emitter.emit(func.body);
+        if (is_failure(result))
+        {
+            return std::move(get_failure(result));
+        }
+        out << "    return " << get_success(result).value << ";\n}\n\n";
+    }
+
+    std::vector<std::string> types;
+    for (size_t i = 0; i < evaluations.size(); ++i)
+    {
+        std::stringstream body;
+        c_function_emitter emitter(env, functions, nullptr, body);
+        auto result = emitter.emit(*evaluations.at(i));
+        if (is_failure(result))
+        {
+            return std::move(get_failure(result));
+        }
+        auto const& [variable, type] = get_success(result);
+        types.push_back(type);
+        out << "int ant_eval_" << i << "(void* result)\n{\n"
+            << "    if (setjmp(ant_error_jump))\n"
+            << "    {\n"
+            << "        return 1;\n"
+            << "    }\n"
+            << body.str()
+            << "    *(" << c_types.at(type) << "*)result = " << variable << ";\n"
+            << "    return 0;\n}\n\n";
+    }
+
+    out << "const size_t ant_eval_count = " << evaluations.size() << ";\n\n";
+    out << "const char* const ant_eval_types[] = {";
+    for (auto const& type : types)
+    {
+        out << '"' << type << "\", ";
+    }
+    out << "NULL};\n";
+
+    return out.str();
+}
+
+} // namespace ant
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ast.hpp"
+#include "compiler.hpp"
+
+#include <string>
+
+namespace ant
+{
+
+// Translates a compiled program into a portable C99 translation unit.
+// Each top-level evaluation i is exported as
+//
+//     int ant_eval_i(void* result);
+//
+// writing its value to result and returning non-zero on arithmetic errors,
+// together with the ant_eval_count and ant_eval_types tables. Programs using
+// structures are not supported.
+exceptional<std::string, compiler_failure>
+emit_c(compiler_environment const& env, ast::program const& program);
+
+} // namespace ant
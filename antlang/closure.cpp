@@ -0,0 +1,340 @@
+#include "closure.hpp"
+
+#include "profiler.hpp"
+
+namespace ant
+{
+namespace runtime
+{
+
+namespace
+{
+
+value_variant invoke_constant(closure const& self)
+{
+    return self.constant;
+}
+
+value_variant invoke_slot(closure const& self)
+{
+    return *self.slots[0];
+}
+
+value_variant invoke_construction(closure const& self)
+{
+    return structure{self.blueprint->parameters};
+}
+
+value_variant invoke_operation(closure const& self)
+{
+    auto const& params = self.blueprint->parameters;
+    return self.impl(params[0], params[1]);
+}
+
+value_variant invoke_slot_operation(closure const& self)
+{
+    return self.impl(*self.slots[0], *self.slots[1]);
+}
+
+value_variant invoke_slot_constant_operation(closure const& self)
+{
+    return self.impl(*self.slots[0], self.constant);
+}
+
+value_variant invoke_constant_slot_operation(closure const& self)
+{
+    return self.impl(self.constant, *self.slots[1]);
+}
+
+value_variant invoke_applied_operation(closure const& self)
+{
+    auto const& lhs = self.operands[0];
+    auto const& rhs = self.operands[1];
+    return self.impl(lhs.invoke(lhs), rhs.invoke(rhs));
+}
+
+value_variant invoke_call(closure const& self)
+{
+    auto& params = self.blueprint->parameters;
+    auto identity = [](value_variant& x) -> value_variant& { return x; };
+    slot_backup backup(params, identity);
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        auto const& arg = self.operands[i];
+        params[i] = arg.invoke(arg);
+    }
+    auto result = self.body->invoke(*self.body);
+    backup.restore(params, identity);
+    return result;
+}
+
+value_variant invoke_condition(closure const& self)
+{
+    auto const& operands = self.operands;
+    const size_t fallback = operands.size() - 1;
+    for (size_t i = 0; i < fallback; i += 2)
+    {
+        auto const& check = operands[i];
+        if (get<bool>(check.invoke(check)))
+        {
+            auto const& value = operands[i + 1];
+            return value.invoke(value);
+        }
+    }
+    return operands[fallback].invoke(operands[fallback]);
+}
+
+value_variant invoke_counted_condition(closure const& self)
+{
+    auto const& operands = self.operands;
+    const size_t fallback = operands.size() - 1;
+    for (size_t i = 0; i < fallback; i += 2)
+    {
+        auto const& check = operands[i];
+        if (get<bool>(check.invoke(check)))
+        {
+            ++self.hits[i / 2];
+            auto const& value = operands[i + 1];
+            return value.invoke(value);
+        }
+    }
+    ++self.hits[fallback / 2];
+    return operands[fallback].invoke(operands[fallback]);
+}
+
+value_variant invoke_guard(closure const& self)
+{
+    auto const& branch = get<bool>(self.impl(*self.slots[0], self.constant))
+        ? self.operands[0]
+        : self.operands[1];
+    return branch.invoke(branch);
+}
+
+value_variant invoke_probe(closure const& self)
+{
+    profiled_call call(*self.instrument->owner, *self.instrument->profile);
+    auto const& value = self.operands[0];
+    return value.invoke(value);
+}
+
+value_variant invoke_scope(closure const& self)
+{
+    auto const& operands = self.operands;
+    auto const& results = self.results;
+    auto dereference = [](value_variant* x) -> value_variant& { return *x; };
+    slot_backup backup(results, dereference);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto const& binding = operands[i];
+        *results[i] = binding.invoke(binding);
+    }
+    auto const& value = operands.back();
+    auto result = value.invoke(value);
+    backup.restore(results, dereference);
+    return result;
+}
+
+struct closure_compiler
+{
+    closure_program& prog;
+
+    template <typename T>
+    closure operator()(recursive_wrapper<T>& x) const
+    {
+        return (*this)(x.get());
+    }
+
+    closure operator()(value_variant& value) const
+    {
+        closure result;
+        result.invoke = invoke_constant;
+        result.constant = value;
+        return result;
+    }
+
+    closure operator()(value_variant* value) const
+    {
+        closure result;
+        result.invoke = invoke_slot;
+        result.slots[0] = value;
+        return result;
+    }
+
+    closure operator()(construction& ctor) const
+    {
+        closure result;
+        result.invoke = invoke_construction;
+        result.blueprint = ctor.prototype;
+        return result;
+    }
+
+    closure operator()(operation& op) const
+    {
+        closure result;
+        result.invoke = invoke_operation;
+        result.impl = op.impl;
+        result.blueprint = op.blueprint;
+        return result;
+    }
+
+    closure operator()(slot_operation& op) const
+    {
+        closure result;
+        result.invoke = invoke_slot_operation;
+        result.impl = op.impl;
+        result.slots[0] = op.lhs;
+        result.slots[1] = op.rhs;
+        return result;
+    }
+
+    closure operator()(slot_constant_operation& op) const
+    {
+        closure result;
+        result.invoke = invoke_slot_constant_operation;
+        result.impl = op.impl;
+        result.slots[0] = op.lhs;
+        result.constant = op.rhs;
+        return result;
+    }
+
+    closure operator()(constant_slot_operation& op) const
+    {
+        closure result;
+        result.invoke = invoke_constant_slot_operation;
+        result.impl = op.impl;
+        result.constant = op.lhs;
+        result.slots[1] = op.rhs;
+        return result;
+    }
+
+    closure operator()(evaluation& eval) const
+    {
+        closure result;
+        result.operands.reserve(eval.arguments.size());
+        for (auto& arg : eval.arguments)
+        {
+            result.operands.push_back(compile_closure(prog, arg));
+        }
+        auto& value = eval.blueprint->value;
+        if (holds<operation>(value))
+        {
+            // apply the operator directly, its parameters are only read by itself
+            result.invoke = invoke_applied_operation;
+            result.impl = get<operation>(value).impl;
+        }
+        else
+        {
+            result.invoke = invoke_call;
+            result.blueprint = eval.blueprint;
+            result.body = compile_closure(prog, *eval.blueprint);
+        }
+        return result;
+    }
+
+    closure operator()(condition& cond) const
+    {
+        closure result;
+        result.invoke = cond.hits ? invoke_counted_condition : invoke_condition;
+        result.hits = cond.hits;
+        result.operands.reserve(2 * cond.branches.size() + 1);
+        for (auto& [check, value] : cond.branches)
+        {
+            result.operands.push_back(compile_closure(prog, check));
+            result.operands.push_back(compile_closure(prog, value));
+        }
+        result.operands.push_back(compile_closure(prog, cond.fallback));
+        return result;
+    }
+
+    closure operator()(guard& expr) const
+    {
+        closure result;
+        result.invoke = invoke_guard;
+        result.impl = expr.check;
+        result.slots[0] = expr.slot;
+        result.constant = expr.constant;
+        result.operands.push_back(compile_closure(prog, expr.value));
+        result.operands.push_back(compile_closure(prog, expr.fallback));
+        return result;
+    }
+
+    closure operator()(probe& expr) const
+    {
+        closure result;
+        result.invoke = invoke_probe;
+        result.instrument = &expr;
+        result.operands.push_back(compile_closure(prog, expr.value));
+        return result;
+    }
+
+    closure operator()(std::unique_ptr<scope>& expr) const
+    {
+        closure result;
+        result.invoke = invoke_scope;
+        result.operands.reserve(expr->bindings.size() + 1);
+        result.results.reserve(expr->bindings.size());
+        for (auto& binding : expr->bindings)
+        {
+            result.operands.push_back(compile_closure(prog, binding.value));
+            result.results.push_back(&binding.result);
+        }
+        result.operands.push_back(compile_closure(prog, expr->value));
+        return result;
+    }
+};
+
+} // namespace
+
+closure compile_closure(closure_program& prog, expression& expr)
+{
+    return visit(closure_compiler{prog}, expr);
+}
+
+closure compile_closure(closure_program& prog, evaluation& eval)
+{
+    return closure_compiler{prog}(eval);
+}
+
+closure const* compile_closure(closure_program& prog, function& func)
+{
+    auto it = prog.bodies.find(&func);
+    if (it != prog.bodies.end())
+    {
+        return it->second.get();
+    }
+    // register the body before compiling it, since it may call itself
+    auto* body = prog.bodies.emplace(&func, std::make_unique<closure>()).first->second.get();
+    *body = compile_closure(prog, func.value);
+    return body;
+}
+
+closure const* promote(tiering& tier, function& func)
+{
+    return compile_closure(tier.closures, func);
+}
+
+void enable_tiering(program& prog, tiering& tier, size_t first)
+{
+    for (size_t i = first; i < prog.functions.size(); ++i)
+    {
+        auto& func = prog.functions[i];
+        if (!holds<operation>(func->value))
+        {
+            func->tier = &tier;
+        }
+    }
+}
+
+closure_program compile_closures(program& prog)
+{
+    closure_program result;
+    result.evaluations.reserve(prog.evaluations.size());
+    for (auto& eval : prog.evaluations)
+    {
+        result.evaluations.push_back(compile_closure(result, eval));
+    }
+    return result;
+}
+
+}  // namespace runtime
+}  // namespace ant
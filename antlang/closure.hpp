@@ -0,0 +1,74 @@
+#pragma once
+
+#include "runtime.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ant
+{
+namespace runtime
+{
+
+struct closure;
+
+using closure_function = value_variant (*)(closure const& self);
+
+// A runtime expression pre-bound into a node invoked through a direct
+// function pointer, selected per node type when compiling the closure.
+struct closure
+{
+    closure_function invoke = nullptr;
+    binary_operator impl = nullptr;
+    value_variant* slots[2] = {nullptr, nullptr};
+    value_variant constant;
+    function* blueprint = nullptr;
+    closure const* body = nullptr;
+    // Branch hit counters of a training condition.
+    uint64_t* hits = nullptr;
+    probe* instrument = nullptr;
+    std::vector<closure> operands;
+    std::vector<value_variant*> results;
+};
+
+struct closure_program
+{
+    std::map<function const*, std::unique_ptr<closure>> bodies;
+    std::vector<closure> evaluations;
+};
+
+// Calls through the tree walker needed before a function is promoted.
+constexpr size_t default_tier_threshold = 1000;
+
+// Owns the closures of functions promoted by the tree walker.
+struct tiering
+{
+    size_t threshold = default_tier_threshold;
+    closure_program closures;
+};
+
+closure compile_closure(closure_program& prog, expression& expr);
+
+closure compile_closure(closure_program& prog, evaluation& eval);
+
+closure const* compile_closure(closure_program& prog, function& func);
+
+closure_program compile_closures(program& prog);
+
+// Compiles the function, and the functions it calls, into closures.
+closure const* promote(tiering& tier, function& func);
+
+// Lets the tree walker count calls to the user defined functions of the
+// program and promote them once they cross the tier threshold. Functions
+// before the first one are left as they are, e.g. when they were enabled
+// before compiling more functions.
+void enable_tiering(program& prog, tiering& tier, size_t first = 0);
+
+inline value_variant execute(closure const& self)
+{
+    return self.invoke(self);
+}
+
+}  // namespace runtime
+}  // namespace ant
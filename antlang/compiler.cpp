@@ -1,5 +1,7 @@
 #include "compiler.hpp"
 
+#include "lazy_functions.hpp"
+
 namespace ant
 {
 
@@ -15,9 +17,13 @@ find_function(compiler_environment const& env,
     }
     for (auto const& [meta, func] : it->second)
     {
+        if (env.lazy && !env.lazy->is_visible(meta))
+        {
+            continue;
+        }
         if (meta.parameter_types == signature)
         {
-            return function_query_result{meta.return_type, func};
+            return function_query_result{meta.return_type, func, meta.inlining};
         }
     }
     return nullptr;
@@ -33,7 +39,8 @@ find_function(compiler_environment const& env,
     {
         return function_query_result{
             scope.function.return_type,
-            scope.function.pointer
+            scope.function.pointer,
+            {false, "recursive", nullptr}
         };
     }
     return find_function(env, name, signature);
@@ -63,6 +70,7 @@ void add_fundamental_operation(
     meta.return_type = ast::name_of_v<ast::literal<ReturnType>>;
     const std::string operand_type = ast::name_of_v<ast::literal<Type>>;
     meta.parameter_types = {operand_type, operand_type};
+    meta.inlining.reason = "built-in operation";
 
     env.functions[name].push_back({std::move(meta), prog.functions.back().get()});
 }
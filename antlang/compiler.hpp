@@ -3,6 +3,8 @@
 #include "exceptional.hpp"
 #include "tokens.hpp"
 #include "ast.hpp"
+#include "branch_profile.hpp"
+#include "ir.hpp"
 #include "runtime.hpp"
 
 #include <map>
@@ -54,10 +56,23 @@ struct compiler_expect : public
     >::exceptional;
 };
 
+// Whether calls of a function are replaced by its body, see inline_calls.
+struct inlining_decision
+{
+    bool inlinable = false;
+    std::string reason;
+    // The optimized body of inlinable functions.
+    std::shared_ptr<ir::function const> body;
+};
+
 struct function_meta
 {
     std::string return_type;
     std::vector<std::string> parameter_types;
+    inlining_decision inlining;
+    // Number of the definition of the function in the program, counted
+    // from 1, or 0 for built-in functions.
+    size_t definition = 0;
 };
 
 struct compiled_function_result
@@ -72,15 +87,42 @@ struct compiled_function_meta
     runtime::function* value;
 };
 
+struct pass_manager;
+
+struct program_profile;
+
+class lazy_functions;
+
 struct compiler_environment
 {
     std::map<std::string, std::vector<compiled_function_meta>> functions;
     std::map<std::string, std::unique_ptr<runtime::value_variant>> prototypes;
+    // Optimization passes run on the ir of every function and evaluation,
+    // none when unset, see passes.hpp.
+    pass_manager* passes = nullptr;
+    // When set, conditions of compiled functions count their branch hits
+    // into it.
+    branch_profile* training = nullptr;
+    // Branch hits of a training run, guiding the reorder-branches pass.
+    branch_profile* profile = nullptr;
+    // When set, the bodies of compiled functions record their calls and
+    // time into it, see profiler.hpp.
+    runtime::profiler* profiler = nullptr;
+    // Calls of a recorded run, guiding inlining, see profile.hpp.
+    program_profile const* recorded = nullptr;
+    // When set, functions parsed without their body are compiled on their
+    // first call, see lazy_functions.hpp.
+    lazy_functions* lazy = nullptr;
+    // Number of functions and structures defined so far.
+    size_t definitions = 0;
 };
 
 struct compiler_scope
 {
     std::map<std::string, compiler_result<runtime::value_variant*>> parameters;
+    std::map<std::string, compiler_result<size_t>> locals;
+    // Shared by the nested scopes of a function to number its locals.
+    std::shared_ptr<size_t> local_count = std::make_shared<size_t>(0);
     struct {
         std::string name;
         std::string return_type;
@@ -93,6 +135,7 @@ struct function_query_result
 {
     std::string return_type;
     runtime::function* function;
+    inlining_decision inlining;
 };
 
 exceptional<function_query_result, nullptr_t>
@@ -118,6 +161,65 @@ compiler_expect<runtime::value_variant*>
 compile(compiler_scope const& scope,
         ast::reference const& ref);
 
+compiler_expect<ir::expression>
+translate(compiler_scope const& scope,
+          ast::reference const& ref);
+
+compiler_expect<ir::call>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::evaluation const& eval);
+
+compiler_expect<ir::condition>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::condition const& cond);
+
+compiler_expect<ir::expression>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::expression const& expr);
+
+compiler_expect<ir::scope>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::scope const& expr);
+
+// Runtime slots of the ir locals lowered so far.
+struct lowering_scope
+{
+    std::map<size_t, runtime::value_variant*> locals;
+    // Hit counters for the conditions in lowering order, when training.
+    std::vector<branch_hits>* branch_counts = nullptr;
+};
+
+runtime::evaluation
+lower(lowering_scope& scope, ir::call const& expr);
+
+runtime::condition
+lower(lowering_scope& scope, ir::condition const& expr);
+
+std::unique_ptr<runtime::scope>
+lower(lowering_scope& scope, ir::scope const& expr);
+
+runtime::expression
+lower(lowering_scope& scope, ir::expression const& expr);
+
+// Lowers a translation on its own, for compiling straight to the runtime.
+template <typename T>
+auto lower(compiler_expect<T>&& translation)
+    -> compiler_expect<decltype(lower(std::declval<lowering_scope&>(), std::declval<T const&>()))>
+{
+    using result_type = decltype(lower(std::declval<lowering_scope&>(), std::declval<T const&>()));
+    if (is_failure(translation))
+    {
+        return std::move(get_failure(translation));
+    }
+    auto& [value, type] = get_success(translation);
+    lowering_scope scope;
+    return compiler_result<result_type>{lower(scope, value), std::move(type)};
+}
+
 compiler_expect<runtime::evaluation>
 compile(compiler_environment const& env,
         compiler_scope const& scope,
@@ -138,10 +240,29 @@ compile(compiler_environment const& env,
         compiler_scope const& scope,
         ast::scope const& expr);
 
+runtime::expression
+fuse(runtime::evaluation&& eval);
+
+runtime::expression
+fuse(runtime::condition&& cond);
+
 exceptional<compiled_function_result, compiler_failure>
 compile(compiler_environment const& env,
         ast::function const& function);
 
+// Checks the signature of a function and makes its runtime function,
+// without compiling its body.
+exceptional<compiled_function_result, compiler_failure>
+declare(compiler_environment const& env,
+        ast::function const& function);
+
+// Compiles the body of a declared function into its runtime function.
+exceptional<inlining_decision, compiler_failure>
+define(compiler_environment const& env,
+       ast::function const& function,
+       std::vector<std::string> const& signature,
+       runtime::function& result);
+
 exceptional<std::unique_ptr<runtime::structure>, compiler_failure>
 compile(compiler_environment const& env,
         ast::structure const& structure);
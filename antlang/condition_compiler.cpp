@@ -7,23 +7,23 @@
 namespace ant
 {
 
-compiler_expect<runtime::condition>
-compile(compiler_environment const& env,
-        compiler_scope const& scope,
-        ast::condition const& cond)
+compiler_expect<ir::condition>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::condition const& cond)
 {
     if (cond.branches.empty())
     {
         return compiler_failure{"Condition must have at least 1 branch", cond.context};
     }
 
-    runtime::condition compiled_condition;
+    ir::condition compiled_condition;
     compiled_condition.branches.reserve(cond.branches.size());
 
-    auto compile_branch = [&env, &scope](auto const& branch)
+    auto translate_branch = [&env, &scope](auto const& branch)
     {
-        auto check = compile(env, scope, branch.check);
-        auto value = compile(env, scope, branch.value);
+        auto check = translate(env, scope, branch.check);
+        auto value = translate(env, scope, branch.value);
         return std::make_pair(std::move(check), std::move(value));
     };
 
@@ -32,7 +32,7 @@ compile(compiler_environment const& env,
     for (size_t i = 0; i < cond.branches.size(); ++i)
     {
         auto const& branch = cond.branches.at(i);
-        auto [check, value] = compile_branch(branch);
+        auto [check, value] = translate_branch(branch);
 
         if (is_failure(check))
         {
@@ -74,7 +74,7 @@ compile(compiler_environment const& env,
         compiled_condition.branches.push_back({std::move(check_expr), std::move(value_expr)});
     }
 
-    auto fallback = compile(env, scope, cond.fallback);
+    auto fallback = translate(env, scope, cond.fallback);
 
     if (is_failure(fallback))
     {
@@ -91,12 +91,21 @@ compile(compiler_environment const& env,
         };
     }
 
+    compiled_condition.type = result_type;
     compiled_condition.fallback = std::move(fallback_expr);
 
-    return compiler_result<runtime::condition>{
+    return compiler_result<ir::condition>{
         std::move(compiled_condition),
         result_type
     };
 }
 
+compiler_expect<runtime::condition>
+compile(compiler_environment const& env,
+        compiler_scope const& scope,
+        ast::condition const& cond)
+{
+    return lower(translate(env, scope, cond));
+}
+
 }  // namespace ant
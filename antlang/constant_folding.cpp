@@ -0,0 +1,94 @@
+#include "passes.hpp"
+
+#include <map>
+
+namespace ant
+{
+
+namespace
+{
+
+struct constant_folder
+{
+    // Let bindings of constants, substituted into their uses.
+    std::map<size_t, ir::constant> constants;
+
+    void operator()(ir::expression& expr)
+    {
+        if (holds<ir::local>(expr))
+        {
+            auto it = constants.find(get<ir::local>(expr).id);
+            if (it != constants.end())
+            {
+                expr = it->second;
+            }
+        }
+        else if (holds<ir::call>(expr))
+        {
+            auto& call = get<ir::call>(expr);
+            for (auto& arg : call.arguments)
+            {
+                (*this)(arg);
+            }
+            if (ir::is_operation(call) &&
+                std::all_of(call.arguments.begin(), call.arguments.end(),
+                            [](auto const& arg) { return holds<ir::constant>(arg); }))
+            {
+                auto const& op = get<runtime::operation>(call.callee->value);
+                try
+                {
+                    auto value = op.impl(get<ir::constant>(call.arguments.at(0)).value,
+                                         get<ir::constant>(call.arguments.at(1)).value);
+                    expr = ir::constant{std::move(value), call.type};
+                }
+                catch (runtime::arithmetic_error const&)
+                {
+                    // leave the error to the runtime
+                }
+            }
+        }
+        else if (holds<ir::condition>(expr))
+        {
+            auto& cond = get<ir::condition>(expr);
+            for (auto& [check, value] : cond.branches)
+            {
+                (*this)(check);
+                (*this)(value);
+            }
+            (*this)(cond.fallback.get());
+        }
+        else if (holds<ir::scope>(expr))
+        {
+            auto& let = get<ir::scope>(expr);
+            std::vector<ir::binding> bindings;
+            for (auto& binding : let.bindings)
+            {
+                (*this)(binding.value);
+                if (holds<ir::constant>(binding.value))
+                {
+                    constants.emplace(binding.id, get<ir::constant>(binding.value));
+                }
+                else
+                {
+                    bindings.push_back(std::move(binding));
+                }
+            }
+            let.bindings = std::move(bindings);
+            (*this)(let.value.get());
+            if (let.bindings.empty())
+            {
+                ir::expression value = std::move(let.value.get());
+                expr = std::move(value);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+void fold_constants(compiler_environment const&, ir::function& func)
+{
+    constant_folder{}(func.body);
+}
+
+}  // namespace ant
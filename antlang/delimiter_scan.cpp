@@ -0,0 +1,170 @@
+#include "delimiter_scan.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ANTLANG_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace ant
+{
+
+namespace
+{
+
+// Sets the bits of the delimiters and spaces of the source from begin on.
+void scan_scalar(std::string_view source, size_t begin, uint64_t* delimiters, uint64_t* spaces)
+{
+    for (size_t i = begin; i < source.size(); ++i)
+    {
+        const uint64_t bit = uint64_t{1} << (i % 64);
+        if (is_delimiter(source[i]))
+        {
+            delimiters[i / 64] |= bit;
+        }
+        if (source[i] == ' ')
+        {
+            spaces[i / 64] |= bit;
+        }
+    }
+}
+
+#if defined(ANTLANG_X86_SIMD)
+
+__attribute__((target("sse2")))
+size_t scan_sse2(std::string_view source, uint64_t* delimiters, uint64_t* spaces)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i others[] = {
+        _mm_set1_epi8('('), _mm_set1_epi8(')'), _mm_set1_epi8('['), _mm_set1_epi8(']'),
+        _mm_set1_epi8(';'), _mm_set1_epi8('\n')
+    };
+    const size_t blocks = source.size() / 64;
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        uint64_t delimiter_word = 0;
+        uint64_t space_word = 0;
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const auto* data = source.data() + block * 64 + lane * 16;
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+            const __m128i is_space = _mm_cmpeq_epi8(bytes, space);
+            __m128i found = is_space;
+            for (auto const& other : others)
+            {
+                found = _mm_or_si128(found, _mm_cmpeq_epi8(bytes, other));
+            }
+            const auto shift = lane * 16;
+            delimiter_word |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(found))} << shift;
+            space_word |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(is_space))} << shift;
+        }
+        delimiters[block] = delimiter_word;
+        spaces[block] = space_word;
+    }
+    return blocks * 64;
+}
+
+__attribute__((target("avx2")))
+size_t scan_avx2(std::string_view source, uint64_t* delimiters, uint64_t* spaces)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i others[] = {
+        _mm256_set1_epi8('('), _mm256_set1_epi8(')'), _mm256_set1_epi8('['), _mm256_set1_epi8(']'),
+        _mm256_set1_epi8(';'), _mm256_set1_epi8('\n')
+    };
+    const size_t blocks = source.size() / 64;
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        uint64_t delimiter_word = 0;
+        uint64_t space_word = 0;
+        for (size_t lane = 0; lane < 2; ++lane)
+        {
+            const auto* data = source.data() + block * 64 + lane * 32;
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+            const __m256i is_space = _mm256_cmpeq_epi8(bytes, space);
+            __m256i found = is_space;
+            for (auto const& other : others)
+            {
+                found = _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, other));
+            }
+            const auto shift = lane * 32;
+            delimiter_word |= uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(found))} << shift;
+            space_word |= uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(is_space))} << shift;
+        }
+        delimiters[block] = delimiter_word;
+        spaces[block] = space_word;
+    }
+    return blocks * 64;
+}
+
+#endif
+
+} // namespace
+
+char const* name_of(scan_isa isa)
+{
+    switch (isa)
+    {
+    case scan_isa::scalar:
+        return "scalar";
+    case scan_isa::sse2:
+        return "sse2";
+    case scan_isa::avx2:
+        return "avx2";
+    }
+    return "unknown";
+}
+
+bool is_supported(scan_isa isa)
+{
+    switch (isa)
+    {
+    case scan_isa::scalar:
+        return true;
+#if defined(ANTLANG_X86_SIMD)
+    case scan_isa::sse2:
+        return __builtin_cpu_supports("sse2");
+    case scan_isa::avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+scan_isa best_scan_isa()
+{
+    static const scan_isa best = [] {
+        for (auto isa : {scan_isa::avx2, scan_isa::sse2})
+        {
+            if (is_supported(isa))
+            {
+                return isa;
+            }
+        }
+        return scan_isa::scalar;
+    }();
+    return best;
+}
+
+delimiter_bitmap::delimiter_bitmap(std::string_view source, scan_isa isa)
+    : delimiters((source.size() + 63) / 64, 0)
+    , spaces(delimiters.size(), 0)
+    , size{source.size()}
+{
+    size_t scanned = 0;
+#if defined(ANTLANG_X86_SIMD)
+    if (isa == scan_isa::avx2 && is_supported(isa))
+    {
+        scanned = scan_avx2(source, delimiters.data(), spaces.data());
+    }
+    else if (isa == scan_isa::sse2 && is_supported(isa))
+    {
+        scanned = scan_sse2(source, delimiters.data(), spaces.data());
+    }
+#else
+    static_cast<void>(isa);
+#endif
+    scan_scalar(source, scanned, delimiters.data(), spaces.data());
+}
+
+} // namespace ant
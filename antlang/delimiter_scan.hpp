@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ant
+{
+
+// Instruction sets to find the delimiters of a source with, scalar finds
+// them one byte at a time while lexing instead.
+enum class scan_isa
+{
+    scalar,
+    sse2,
+    avx2
+};
+
+char const* name_of(scan_isa isa);
+
+bool is_supported(scan_isa isa);
+
+// Widest instruction set supported by the processor running the program.
+scan_isa best_scan_isa();
+
+// Bytes ending identifiers, which are '(', ')', '[', ']', ' ', ';' and '\n'.
+constexpr bool is_delimiter(char c)
+{
+    return c == '(' || c == ')' || c == '[' || c == ']' ||
+           c == ' ' || c == ';' || c == '\n';
+}
+
+// Bits of the bytes of a source telling whether they are delimiters and
+// whether they are spaces, found 16 or 32 bytes at a time, so that lexing
+// skips to the next delimiter or token instead of testing every byte.
+class delimiter_bitmap
+{
+public:
+    delimiter_bitmap(std::string_view source, scan_isa isa);
+
+    bool is_delimiter(size_t position) const
+    {
+        return (delimiters[position / 64] >> (position % 64)) & 1;
+    }
+
+    // Position of the first delimiter at or after the given position, or
+    // the size of the source when there is none.
+    size_t next_delimiter(size_t position) const
+    {
+        return next_set(delimiters, position, 0);
+    }
+
+    // Position of the first byte other than a space at or after the given
+    // position, or the size of the source when there is none.
+    size_t next_non_space(size_t position) const
+    {
+        return next_set(spaces, position, ~uint64_t{0});
+    }
+
+private:
+    std::vector<uint64_t> delimiters;
+    std::vector<uint64_t> spaces;
+    size_t size;
+
+    size_t next_set(std::vector<uint64_t> const& words, size_t position, uint64_t flip) const
+    {
+        size_t index = position / 64;
+        if (index >= words.size())
+        {
+            return size;
+        }
+        uint64_t word = (words[index] ^ flip) & (~uint64_t{0} << (position % 64));
+        while (word == 0)
+        {
+            if (++index == words.size())
+            {
+                return size;
+            }
+            word = words[index] ^ flip;
+        }
+        const size_t result = index * 64 + __builtin_ctzll(word);
+        return result < size ? result : size;
+    }
+};
+
+} // namespace ant
@@ -13,8 +13,8 @@ template <typename T>
 struct parser<discard<T>>
 {
     parser_result<none>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         const auto parser = make_parser<T>();
         auto result = parser.parse(pos, end);
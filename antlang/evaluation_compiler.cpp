@@ -1,23 +1,24 @@
 #include "compiler.hpp"
 
 #include "formatting.hpp"
+#include "lazy_functions.hpp"
 
 #include <sstream>
 
 namespace ant
 {
 
-compiler_expect<runtime::evaluation>
-compile(compiler_environment const& env,
-        compiler_scope const& scope,
-        ast::evaluation const& eval)
+compiler_expect<ir::call>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::evaluation const& eval)
 {
-    std::vector<compiler_result<runtime::expression>> arguments;
+    std::vector<compiler_result<ir::expression>> arguments;
     arguments.reserve(eval.arguments.size());
 
     for (const auto& arg : eval.arguments)
     {
-        auto expr = compile(env, scope, arg);
+        auto expr = translate(env, scope, arg);
         if (is_success(expr))
         {
             arguments.push_back(std::move(get_success(expr)));
@@ -50,18 +51,34 @@ compile(compiler_environment const& env,
         message << ")";
         return compiler_failure{message.str(), eval.context};
     }
-    auto& [return_type, func_ptr] = get_success(func_query);
+    auto& [return_type, func_ptr, inlining] = get_success(func_query);
+    if (env.lazy)
+    {
+        if (auto failure = env.lazy->compile(env, func_ptr))
+        {
+            return std::move(*failure);
+        }
+    }
 
-    auto result = runtime::evaluation(func_ptr);
+    ir::call result{eval.function, return_type, func_ptr, {}};
+    result.arguments.reserve(arguments.size());
     std::transform(std::move_iterator(arguments.begin()),
                    std::move_iterator(arguments.end()),
-                   result.arguments.begin(),
+                   std::back_inserter(result.arguments),
                    [](auto&& arg) { return std::move(arg.value); });
 
-    return compiler_result<runtime::evaluation>{
+    return compiler_result<ir::call>{
         std::move(result),
         return_type
     };
 }
 
+compiler_expect<runtime::evaluation>
+compile(compiler_environment const& env,
+        compiler_scope const& scope,
+        ast::evaluation const& eval)
+{
+    return lower(translate(env, scope, eval));
+}
+
 }  // namespace ant
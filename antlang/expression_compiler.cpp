@@ -3,34 +3,25 @@
 namespace ant
 {
 
-struct expression_compiler
+struct expression_translator
 {
     compiler_environment const& env;
     compiler_scope const& scope;
 
-    compiler_expect<runtime::expression>
+    compiler_expect<ir::expression>
     operator()(ast::reference const& ref)
     {
-        compiler_expect<runtime::value_variant*> result = compile(scope, ref);
-        if (is_success(result))
-        {
-            auto& [value, type] = get_success(result);
-            return compiler_result<runtime::expression>{std::move(value), std::move(type)};
-        }
-        else
-        {
-            return std::move(get_failure(result));
-        }
+        return translate(scope, ref);
     }
 
-    compiler_expect<runtime::expression>
+    compiler_expect<ir::expression>
     operator()(ast::literal_variant const& literal)
     {
         compiler_expect<runtime::value_variant> result = compile(env, literal);
         if (is_success(result))
         {
             auto& [value, type] = get_success(result);
-            return compiler_result<runtime::expression>{std::move(value), std::move(type)};
+            return compiler_result<ir::expression>{ir::constant{std::move(value), type}, type};
         }
         else
         {
@@ -38,44 +29,15 @@ struct expression_compiler
         }
     }
 
-    compiler_expect<runtime::expression>
-    operator()(ast::evaluation const& eval)
+    template <typename T>
+    compiler_expect<ir::expression>
+    operator()(T const& expr)
     {
-        compiler_expect<runtime::evaluation> result = compile(env, scope, eval);
+        auto result = translate(env, scope, expr);
         if (is_success(result))
         {
             auto& [value, type] = get_success(result);
-            return compiler_result<runtime::expression>{std::move(value), std::move(type)};
-        }
-        else
-        {
-            return std::move(get_failure(result));
-        }
-    }
-
-    compiler_expect<runtime::expression>
-    operator()(ast::condition const& cond)
-    {
-        compiler_expect<runtime::condition> result = compile(env, scope, cond);
-        if (is_success(result))
-        {
-            auto& [value, type] = get_success(result);
-            return compiler_result<runtime::expression>{std::move(value), std::move(type)};
-        }
-        else
-        {
-            return std::move(get_failure(result));
-        }
-    }
-
-    compiler_expect<runtime::expression>
-    operator()(ast::scope const& expr)
-    {
-        compiler_expect<std::unique_ptr<runtime::scope>> result = compile(env, scope, expr);
-        if (is_success(result))
-        {
-            auto& [value, type] = get_success(result);
-            return compiler_result<runtime::expression>{std::move(value), std::move(type)};
+            return compiler_result<ir::expression>{std::move(value), std::move(type)};
         }
         else
         {
@@ -84,12 +46,20 @@ struct expression_compiler
     }
 };
 
+compiler_expect<ir::expression>
+translate(compiler_environment const& env,
+          compiler_scope const& scope,
+          ast::expression const& expr)
+{
+    return visit(expression_translator{env, scope}, expr);
+}
+
 compiler_expect<runtime::expression>
 compile(compiler_environment const& env,
         compiler_scope const& scope,
         ast::expression const& expr)
 {
-    return visit(expression_compiler{env, scope}, expr);
+    return lower(translate(env, scope, expr));
 }
 
 }  // namespace ant
@@ -0,0 +1,44 @@
+#include "form_boundaries.hpp"
+
+namespace ant
+{
+
+std::vector<size_t> split_at_forms(std::string_view source, size_t parts)
+{
+    std::vector<size_t> boundaries = {0};
+    long depth = 0;
+    size_t position = 0;
+    while (position < source.size() && boundaries.size() < parts)
+    {
+        switch (source[position])
+        {
+        case '(':
+        case '[':
+            depth += 1;
+            break;
+        case ')':
+        case ']':
+            depth -= 1;
+            break;
+        case ';':
+            position = source.find('\n', position);
+            continue;
+        case '\n':
+            if (depth <= 0)
+            {
+                depth = 0;
+                const size_t start = position + 1;
+                if (start < source.size() && start >= boundaries.size() * source.size() / parts)
+                {
+                    boundaries.push_back(start);
+                }
+            }
+            break;
+        }
+        position += 1;
+    }
+    boundaries.push_back(source.size());
+    return boundaries;
+}
+
+} // namespace ant
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace ant
+{
+
+// Splits a source into at most the given number of parts of about the same
+// size, made of whole top-level forms. Parts start at lines before which
+// every bracket outside of comments is closed, and since tokens and comments
+// end at the end of their line, every part is lexed and parsed on its own.
+// A closing bracket without an opening one is forgotten at the end of its
+// line. Returns the offsets of the parts from 0 to the size of the source.
+std::vector<size_t> split_at_forms(std::string_view source, size_t parts);
+
+} // namespace ant
@@ -1,6 +1,8 @@
 #include "compiler.hpp"
 
 #include "formatting.hpp"
+#include "passes.hpp"
+#include "profiler.hpp"
 
 #include <sstream>
 
@@ -8,7 +10,7 @@ namespace ant
 {
 
 exceptional<compiled_function_result, compiler_failure>
-compile(compiler_environment const& env,
+declare(compiler_environment const& env,
         ast::function const& function)
 {
     if (env.prototypes.find(function.return_type.name) == env.prototypes.end())
@@ -47,41 +49,106 @@ compile(compiler_environment const& env,
         return compiler_failure{message.str(), function.context};
     }
 
+    return compiled_function_result{
+        function_meta{
+            function.return_type.name,
+            std::move(signature),
+            {}
+        },
+        std::move(result)
+    };
+}
+
+exceptional<inlining_decision, compiler_failure>
+define(compiler_environment const& env,
+       ast::function const& function,
+       std::vector<std::string> const& signature,
+       runtime::function& result)
+{
     compiler_scope scope;
-    scope.function = {function.name, function.return_type.name, signature, result.get()};
-    for (size_t i = 0; i < result->parameters.size(); ++i)
+    scope.function = {function.name, function.return_type.name, signature, &result};
+    for (size_t i = 0; i < result.parameters.size(); ++i)
     {
         std::string param_name = function.parameters.at(i).name;
-        scope.parameters[param_name] = {&result->parameters.at(i), signature.at(i)};
+        scope.parameters[param_name] = {&result.parameters.at(i), signature.at(i)};
     }
-    auto compiled_expr = compile(env, scope, function.body);
-    if (is_success(compiled_expr))
+    auto translated_expr = translate(env, scope, function.body);
+    if (is_failure(translated_expr))
     {
-        auto& [value_expr, value_type] = get_success(compiled_expr);
-        if (value_type != function.return_type.name)
-        {
-            std::stringstream message;
-            message << "Function expression type " << quote(value_type)
-                    << " does not match declared return type " << quote(function.return_type.name);
-            return compiler_failure{
-                message.str(),
-                ast::get_context(function.body)
-            };
-        }
-        result->value = std::move(value_expr);
+        return std::move(get_failure(translated_expr));
     }
-    else
+
+    auto& [value_expr, value_type] = get_success(translated_expr);
+    if (value_type != function.return_type.name)
     {
-        return std::move(get_failure(compiled_expr));
+        std::stringstream message;
+        message << "Function expression type " << quote(value_type)
+                << " does not match declared return type " << quote(function.return_type.name);
+        return compiler_failure{
+            message.str(),
+            ast::get_context(function.body)
+        };
     }
 
-    return compiled_function_result{
-        function_meta{
-            function.return_type.name,
-            std::move(signature)
-        },
-        std::move(result)
-    };
+    ir::function translated;
+    translated.name = function.name;
+    translated.return_type = function.return_type.name;
+    translated.pointer = &result;
+    for (size_t i = 0; i < result.parameters.size(); ++i)
+    {
+        std::string const& param_name = function.parameters.at(i).name;
+        translated.parameters.push_back({param_name, signature.at(i), &result.parameters.at(i)});
+    }
+    translated.locals = *scope.local_count;
+    translated.body = std::move(value_expr);
+
+    if (env.passes)
+    {
+        run_passes(*env.passes, env, translated);
+    }
+
+    const std::string key = profile_key(function.name, signature);
+    lowering_scope lowering;
+    if (env.training)
+    {
+        auto& counts = env.training->functions[key];
+        counts.clear();
+        lowering.branch_counts = &counts;
+    }
+    result.value = lower(lowering, translated.body);
+    if (env.profiler)
+    {
+        auto& profile = env.profiler->functions[key];
+        profile = {};
+        runtime::probe probe{env.profiler, &profile, std::move(result.value)};
+        result.value = std::move(probe);
+    }
+
+    inlining_decision inlining = decide_inlining(env, translated);
+    if (inlining.inlinable)
+    {
+        inlining.body = std::make_shared<ir::function const>(std::move(translated));
+    }
+    return inlining;
+}
+
+exceptional<compiled_function_result, compiler_failure>
+compile(compiler_environment const& env,
+        ast::function const& function)
+{
+    auto declared = declare(env, function);
+    if (is_failure(declared))
+    {
+        return std::move(get_failure(declared));
+    }
+    auto& [meta, result] = get_success(declared);
+    auto inlining = define(env, function, meta.parameter_types, *result);
+    if (is_failure(inlining))
+    {
+        return std::move(get_failure(inlining));
+    }
+    meta.inlining = std::move(get_success(inlining));
+    return std::move(get_success(declared));
 }
 
 }  // namespace ant
@@ -0,0 +1,171 @@
+#include "histogram.hpp"
+
+#include <sstream>
+
+namespace ant
+{
+namespace runtime
+{
+
+namespace
+{
+
+struct node_name
+{
+    template <typename T>
+    std::string operator()(recursive_wrapper<T> const& x) const
+    {
+        return (*this)(x.get());
+    }
+
+    std::string operator()(value_variant const&) const
+    {
+        return "value";
+    }
+
+    std::string operator()(value_variant* const&) const
+    {
+        return "slot";
+    }
+
+    std::string operator()(construction const&) const
+    {
+        return "construction";
+    }
+
+    std::string operator()(operation const&) const
+    {
+        return "operation";
+    }
+
+    std::string operator()(slot_operation const&) const
+    {
+        return "slot-operation";
+    }
+
+    std::string operator()(slot_constant_operation const&) const
+    {
+        return "slot-constant-operation";
+    }
+
+    std::string operator()(constant_slot_operation const&) const
+    {
+        return "constant-slot-operation";
+    }
+
+    std::string operator()(evaluation const& eval) const
+    {
+        std::stringstream name;
+        name << "evaluation(";
+        for (size_t i = 0; i < eval.arguments.size(); ++i)
+        {
+            name << (i > 0 ? " " : "") << visit(node_name(), eval.arguments.at(i));
+        }
+        name << ")";
+        return name.str();
+    }
+
+    std::string operator()(condition const&) const
+    {
+        return "condition";
+    }
+
+    std::string operator()(guard const&) const
+    {
+        return "guard";
+    }
+
+    std::string operator()(probe const&) const
+    {
+        return "probe";
+    }
+
+    std::string operator()(std::unique_ptr<scope> const&) const
+    {
+        return "scope";
+    }
+};
+
+struct node_counter
+{
+    node_histogram& histogram;
+
+    template <typename T>
+    void operator()(recursive_wrapper<T> const& x) const
+    {
+        (*this)(x.get());
+    }
+
+    template <typename Leaf>
+    void operator()(Leaf const&) const
+    {
+    }
+
+    void operator()(evaluation const& eval) const
+    {
+        for (auto const& arg : eval.arguments)
+        {
+            count_nodes(histogram, arg);
+        }
+    }
+
+    void operator()(condition const& cond) const
+    {
+        for (auto const& [check, value] : cond.branches)
+        {
+            count_nodes(histogram, check);
+            count_nodes(histogram, value);
+        }
+        count_nodes(histogram, cond.fallback);
+    }
+
+    void operator()(guard const& expr) const
+    {
+        count_nodes(histogram, expr.value);
+        count_nodes(histogram, expr.fallback);
+    }
+
+    void operator()(probe const& expr) const
+    {
+        count_nodes(histogram, expr.value);
+    }
+
+    void operator()(std::unique_ptr<scope> const& expr) const
+    {
+        for (auto const& binding : expr->bindings)
+        {
+            count_nodes(histogram, binding.value);
+        }
+        count_nodes(histogram, expr->value);
+    }
+};
+
+} // namespace
+
+void count_nodes(node_histogram& histogram, expression const& expr)
+{
+    histogram[visit(node_name(), expr)] += 1;
+    visit(node_counter{histogram}, expr);
+}
+
+node_histogram make_histogram(program const& prog)
+{
+    node_histogram histogram;
+    for (auto const& func : prog.functions)
+    {
+        // skip the built-in operations, they are part of every program
+        if (!holds<operation>(func->value))
+        {
+            count_nodes(histogram, func->value);
+        }
+    }
+    for (auto const& eval : prog.evaluations)
+    {
+        histogram[node_name()(eval)] += 1;
+        node_counter{histogram}(eval);
+    }
+    return histogram;
+}
+
+}  // namespace runtime
+}  // namespace ant
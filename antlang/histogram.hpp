@@ -0,0 +1,23 @@
+#pragma once
+
+#include "runtime.hpp"
+
+#include <map>
+#include <string>
+
+namespace ant
+{
+namespace runtime
+{
+
+// Static count of runtime node types, keyed by node name. Evaluations are
+// further keyed by the node names of their arguments, e.g.
+// "evaluation(slot value)", to spot candidates for new superinstructions.
+using node_histogram = std::map<std::string, size_t>;
+
+void count_nodes(node_histogram& histogram, expression const& expr);
+
+node_histogram make_histogram(program const& prog);
+
+}  // namespace runtime
+}  // namespace ant
@@ -0,0 +1,274 @@
+#include "passes.hpp"
+#include "profile.hpp"
+
+#include <map>
+#include <sstream>
+
+namespace ant
+{
+
+namespace
+{
+
+struct node_counter
+{
+    size_t operator()(ir::constant const&) const
+    {
+        return 1;
+    }
+
+    size_t operator()(ir::parameter const&) const
+    {
+        return 1;
+    }
+
+    size_t operator()(ir::local const&) const
+    {
+        return 1;
+    }
+
+    size_t operator()(ir::call const& expr) const
+    {
+        size_t count = 1;
+        for (auto const& arg : expr.arguments)
+        {
+            count += visit(*this, arg);
+        }
+        return count;
+    }
+
+    size_t operator()(ir::condition const& expr) const
+    {
+        size_t count = 1 + visit(*this, expr.fallback.get());
+        for (auto const& [check, value] : expr.branches)
+        {
+            count += visit(*this, check) + visit(*this, value);
+        }
+        return count;
+    }
+
+    size_t operator()(ir::scope const& expr) const
+    {
+        size_t count = 1 + visit(*this, expr.value.get());
+        for (auto const& binding : expr.bindings)
+        {
+            count += visit(*this, binding.value);
+        }
+        return count;
+    }
+};
+
+struct call_finder
+{
+    runtime::function const* target;
+
+    bool operator()(ir::call const& expr) const
+    {
+        return expr.callee == target ||
+               std::any_of(expr.arguments.begin(), expr.arguments.end(),
+                           [this](auto const& arg) { return visit(*this, arg); });
+    }
+
+    bool operator()(ir::condition const& expr) const
+    {
+        return visit(*this, expr.fallback.get()) ||
+               std::any_of(expr.branches.begin(), expr.branches.end(),
+                           [this](auto const& branch)
+                           {
+                               return visit(*this, branch.check) || visit(*this, branch.value);
+                           });
+    }
+
+    bool operator()(ir::scope const& expr) const
+    {
+        return visit(*this, expr.value.get()) ||
+               std::any_of(expr.bindings.begin(), expr.bindings.end(),
+                           [this](auto const& binding) { return visit(*this, binding.value); });
+    }
+
+    template <typename T>
+    bool operator()(T const&) const
+    {
+        return false;
+    }
+};
+
+bool is_atom(ir::expression const& expr)
+{
+    return holds<ir::constant>(expr) || holds<ir::parameter>(expr) || holds<ir::local>(expr);
+}
+
+// Rewrites a copy of the callee body into the caller, replacing parameters
+// by the arguments and moving the callee locals past the caller locals.
+struct body_substitution
+{
+    std::map<runtime::value_variant const*, ir::expression> arguments;
+    size_t local_offset;
+
+    void operator()(ir::expression& expr) const
+    {
+        if (holds<ir::parameter>(expr))
+        {
+            expr = arguments.at(get<ir::parameter>(expr).slot);
+        }
+        else if (holds<ir::local>(expr))
+        {
+            get<ir::local>(expr).id += local_offset;
+        }
+        else if (holds<ir::call>(expr))
+        {
+            for (auto& arg : get<ir::call>(expr).arguments)
+            {
+                (*this)(arg);
+            }
+        }
+        else if (holds<ir::condition>(expr))
+        {
+            auto& cond = get<ir::condition>(expr);
+            for (auto& [check, value] : cond.branches)
+            {
+                (*this)(check);
+                (*this)(value);
+            }
+            (*this)(cond.fallback.get());
+        }
+        else if (holds<ir::scope>(expr))
+        {
+            auto& let = get<ir::scope>(expr);
+            for (auto& binding : let.bindings)
+            {
+                binding.id += local_offset;
+                (*this)(binding.value);
+            }
+            (*this)(let.value.get());
+        }
+    }
+};
+
+struct call_inliner
+{
+    compiler_environment const& env;
+    ir::function& caller;
+
+    // Atomic arguments are substituted directly, others are bound to new
+    // locals evaluated in argument order before the body, like a call.
+    ir::expression expand(ir::call& call, ir::function const& callee)
+    {
+        body_substitution substitution{{}, caller.locals};
+        caller.locals += callee.locals;
+        ir::scope arguments;
+        arguments.type = call.type;
+        for (size_t i = 0; i < callee.parameters.size(); ++i)
+        {
+            auto const& param = callee.parameters.at(i);
+            auto& arg = call.arguments.at(i);
+            if (is_atom(arg))
+            {
+                substitution.arguments.emplace(param.slot, std::move(arg));
+                continue;
+            }
+            const size_t id = caller.locals++;
+            substitution.arguments.emplace(param.slot, ir::local{param.name, param.type, id});
+            arguments.bindings.push_back({param.name, id, std::move(arg), *param.slot});
+        }
+        ir::expression body = callee.body;
+        substitution(body);
+        if (arguments.bindings.empty())
+        {
+            return body;
+        }
+        arguments.value = std::move(body);
+        return arguments;
+    }
+
+    void operator()(ir::expression& expr)
+    {
+        if (holds<ir::call>(expr))
+        {
+            auto& call = get<ir::call>(expr);
+            for (auto& arg : call.arguments)
+            {
+                (*this)(arg);
+            }
+            if (ir::is_operation(call) || call.callee == caller.pointer)
+            {
+                return;
+            }
+            std::vector<std::string> signature;
+            std::transform(call.arguments.begin(), call.arguments.end(),
+                           std::back_inserter(signature),
+                           [](auto const& arg) { return ir::type_of(arg); });
+            auto query = find_function(env, call.function, signature);
+            if (is_success(query) && get_success(query).inlining.inlinable)
+            {
+                ir::expression inlined = expand(call, *get_success(query).inlining.body);
+                expr = std::move(inlined);
+            }
+        }
+        else if (holds<ir::condition>(expr))
+        {
+            auto& cond = get<ir::condition>(expr);
+            for (auto& [check, value] : cond.branches)
+            {
+                (*this)(check);
+                (*this)(value);
+            }
+            (*this)(cond.fallback.get());
+        }
+        else if (holds<ir::scope>(expr))
+        {
+            auto& let = get<ir::scope>(expr);
+            for (auto& binding : let.bindings)
+            {
+                (*this)(binding.value);
+            }
+            (*this)(let.value.get());
+        }
+    }
+};
+
+}  // namespace
+
+size_t count_nodes(ir::expression const& expr)
+{
+    return visit(node_counter{}, expr);
+}
+
+inlining_decision decide_inlining(compiler_environment const& env, ir::function const& func)
+{
+    inlining_decision decision;
+    if (visit(call_finder{func.pointer}, func.body))
+    {
+        decision.reason = "recursive";
+        return decision;
+    }
+    size_t limit = inline_size_limit;
+    std::stringstream reason;
+    if (env.recorded)
+    {
+        auto it = env.recorded->functions.find(profile_key(func));
+        if (it != env.recorded->functions.end() && it->second.calls == 0)
+        {
+            decision.reason = "not called in the profile";
+            return decision;
+        }
+        if (it != env.recorded->functions.end() && it->second.calls >= hot_call_count)
+        {
+            limit *= 2;
+            reason << "hot ";
+        }
+    }
+    const size_t size = count_nodes(func.body);
+    reason << "body of " << size << " nodes";
+    decision.inlinable = size <= limit;
+    reason << (decision.inlinable ? " within" : " exceeds") << " the limit of " << limit;
+    decision.reason = reason.str();
+    return decision;
+}
+
+void inline_calls(compiler_environment const& env, ir::function& func)
+{
+    call_inliner{env, func}(func.body);
+}
+
+}  // namespace ant
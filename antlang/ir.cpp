@@ -0,0 +1,174 @@
+#include "ir.hpp"
+
+namespace ant
+{
+namespace ir
+{
+
+namespace
+{
+
+struct type_query
+{
+    template <typename T>
+    std::string const& operator()(T const& x) const
+    {
+        return x.type;
+    }
+};
+
+struct value_printer
+{
+    std::ostream& out;
+
+    void operator()(bool x) const
+    {
+        out << (x ? "true" : "false");
+    }
+
+    void operator()(int8_t x) const
+    {
+        out << static_cast<int>(x);
+    }
+
+    void operator()(uint8_t x) const
+    {
+        out << static_cast<unsigned>(x);
+    }
+
+    void operator()(runtime::structure const&) const
+    {
+        out << "structure";
+    }
+
+    template <typename T>
+    void operator()(T x) const
+    {
+        out << x;
+    }
+};
+
+bool is_atom(expression const& expr)
+{
+    return holds<constant>(expr) || holds<parameter>(expr) || holds<local>(expr);
+}
+
+// Calls with only atomic arguments are printed on a single line.
+bool is_flat(call const& expr)
+{
+    return std::all_of(expr.arguments.begin(), expr.arguments.end(), is_atom);
+}
+
+void newline(std::ostream& out, size_t indent)
+{
+    out << '\n' << std::string(indent, ' ');
+}
+
+struct expression_printer
+{
+    std::ostream& out;
+    size_t indent;
+
+    void operator()(constant const& expr) const
+    {
+        out << '(' << expr.type << ' ';
+        visit(value_printer{out}, expr.value);
+        out << ')';
+    }
+
+    void operator()(parameter const& expr) const
+    {
+        out << '%' << expr.name;
+    }
+
+    void operator()(local const& expr) const
+    {
+        out << '%' << expr.name << '.' << expr.id;
+    }
+
+    void operator()(call const& expr) const
+    {
+        out << '(' << expr.function << ':' << expr.type;
+        const bool flat = is_flat(expr);
+        for (auto const& arg : expr.arguments)
+        {
+            if (flat)
+            {
+                out << ' ';
+            }
+            else
+            {
+                newline(out, indent + 2);
+            }
+            print(out, arg, indent + 2);
+        }
+        out << ')';
+    }
+
+    void operator()(condition const& expr) const
+    {
+        out << "(when:" << expr.type;
+        for (auto const& [check, value] : expr.branches)
+        {
+            newline(out, indent + 2);
+            out << '[';
+            print(out, check, indent + 3);
+            newline(out, indent + 3);
+            print(out, value, indent + 3);
+            out << ']';
+        }
+        newline(out, indent + 2);
+        print(out, expr.fallback.get(), indent + 2);
+        out << ')';
+    }
+
+    void operator()(scope const& expr) const
+    {
+        out << "(let:" << expr.type;
+        for (auto const& binding : expr.bindings)
+        {
+            newline(out, indent + 2);
+            out << "[%" << binding.name << '.' << binding.id;
+            newline(out, indent + 3);
+            print(out, binding.value, indent + 3);
+            out << ']';
+        }
+        newline(out, indent + 2);
+        print(out, expr.value.get(), indent + 2);
+        out << ')';
+    }
+};
+
+}  // namespace
+
+std::string const& type_of(expression const& expr)
+{
+    return visit(type_query{}, expr);
+}
+
+bool is_operation(call const& expr)
+{
+    return holds<runtime::operation>(expr.callee->value);
+}
+
+void print(std::ostream& out, expression const& expr, size_t indent)
+{
+    visit(expression_printer{out, indent}, expr);
+}
+
+void print(std::ostream& out, function const& func)
+{
+    out << "(function " << func.name << ' ' << func.return_type << " (";
+    for (size_t i = 0; i < func.parameters.size(); ++i)
+    {
+        auto const& param = func.parameters.at(i);
+        out << (i == 0 ? "" : " ") << param.type << " %" << param.name;
+    }
+    out << ')';
+    newline(out, 2);
+    print(out, func.body, 2);
+    out << ")\n";
+}
+
+}  // namespace ir
+}  // namespace ant
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "recursive_variant.hpp"
+#include "runtime.hpp"
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+namespace ir
+{
+
+// Typed intermediate representation between the ast and the runtime.
+// Every value is defined exactly once, either as a function parameter or
+// as a let binding local numbered uniquely within its function, which
+// lets optimization passes substitute and move expressions freely.
+
+struct constant
+{
+    runtime::value_variant value;
+    std::string type;
+};
+
+struct parameter
+{
+    std::string name;
+    std::string type;
+    runtime::value_variant* slot;
+};
+
+struct local
+{
+    std::string name;
+    std::string type;
+    size_t id;
+};
+
+struct call;
+struct condition;
+struct scope;
+struct branch;
+struct binding;
+
+using expression =
+    recursive_variant<
+        constant,
+        parameter,
+        local,
+        call,
+        condition,
+        scope
+    >;
+
+struct call
+{
+    std::string function;
+    std::string type;
+    runtime::function* callee;
+    std::vector<expression> arguments;
+};
+
+struct condition
+{
+    std::string type;
+    std::vector<branch> branches;
+    recursive_wrapper<expression> fallback;
+};
+
+struct scope
+{
+    std::string type;
+    std::vector<binding> bindings;
+    recursive_wrapper<expression> value;
+};
+
+struct branch
+{
+    expression check;
+    expression value;
+};
+
+struct binding
+{
+    std::string name;
+    size_t id;
+    expression value;
+    // Initial result of the binding, otherwise found by evaluating the
+    // value when lowering.
+    std::optional<runtime::value_variant> prototype;
+};
+
+struct function
+{
+    std::string name;
+    std::string return_type;
+    std::vector<parameter> parameters;
+    runtime::function* pointer = nullptr;
+    // Number of locals, the next free local id.
+    size_t locals = 0;
+    expression body;
+};
+
+std::string const& type_of(expression const& expr);
+
+// Calls of built-in operations, which have no body to optimize.
+bool is_operation(call const& expr);
+
+void print(std::ostream& out, expression const& expr, size_t indent = 0);
+
+void print(std::ostream& out, function const& func);
+
+}  // namespace ir
+}  // namespace ant
@@ -0,0 +1,214 @@
+#include "lazy_functions.hpp"
+
+#include "formatting.hpp"
+#include "parser.hpp"
+
+#include <sstream>
+#include <utility>
+
+namespace ant
+{
+
+namespace
+{
+
+// A function definition up to its body.
+using function_header =
+    sequence<
+        left_parenthesis_token,
+        function_token,
+        identifier_token,
+        ast::reference,
+        left_parenthesis_token,
+        repetition<
+            ast::parameter,
+            right_parenthesis_token
+        >
+    >;
+
+// Index of the parenthesis closing the form of a body starting at begin,
+// none when the brackets of the body do not match.
+std::optional<size_t> find_body_end(token_stream const& tokens, size_t begin)
+{
+    long depth = 0;
+    for (size_t i = begin; i < tokens.size(); ++i)
+    {
+        const auto kind = tokens.kind(i);
+        if (kind == token_kind_of_v<left_parenthesis_token> ||
+            kind == token_kind_of_v<left_bracket_token>)
+        {
+            depth += 1;
+        }
+        else if (kind == token_kind_of_v<right_parenthesis_token> ||
+                 kind == token_kind_of_v<right_bracket_token>)
+        {
+            if (depth == 0)
+            {
+                if (kind != token_kind_of_v<right_parenthesis_token> || i == begin)
+                {
+                    return std::nullopt;
+                }
+                return i;
+            }
+            depth -= 1;
+        }
+        else if (kind == token_kind_of_v<end_of_input_token>)
+        {
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+// The function at the position with its body deferred, none when it is not
+// a function or its body cannot be skipped.
+std::optional<parser_success<ast::function>>
+parse_declaration(token_stream const& tokens, token_iterator pos)
+{
+    if (!holds<left_parenthesis_token>(*pos) || !holds<function_token>(*(pos + 1)))
+    {
+        return std::nullopt;
+    }
+    auto header = make_parser<function_header>().parse(pos, tokens.cend());
+    if (is_failure(header))
+    {
+        return std::nullopt;
+    }
+    auto& [values, body] = get_success(header);
+    const size_t begin = body - tokens.cbegin();
+    const auto end = find_body_end(tokens, begin);
+    if (!end)
+    {
+        return std::nullopt;
+    }
+    auto& [name, return_type, parameters] = values;
+    ast::function function{std::move(name), std::move(return_type), std::move(parameters)};
+    function.context = pos->context();
+    function.deferred_body = token_span{&tokens, begin, *end};
+    return parser_success<ast::function>{std::move(function), tokens.cbegin() + *end + 1};
+}
+
+// The innermost failure, which tells what was expected where.
+parser_failure const& innermost(parser_failure const& failure)
+{
+    return failure.children.empty() ? failure : innermost(failure.children.back());
+}
+
+compiler_failure body_failure(ast::function const& function, parser_failure const& failure)
+{
+    auto const& cause = innermost(failure);
+    std::stringstream message;
+    message << "Failed to parse the body of function " << quote(function.name) << ": " << cause.message;
+    return compiler_failure{message.str(), cause.position->context()};
+}
+
+} // namespace
+
+parser_result<ast::program> parse_lazily(token_stream const& tokens)
+{
+    const auto parser = make_parser<ast::statement>();
+    ast::program program;
+    auto pos = tokens.cbegin();
+    while (pos != tokens.cend() && !holds<end_of_input_token>(*pos))
+    {
+        if (auto declaration = parse_declaration(tokens, pos))
+        {
+            program.statements.push_back(std::move(declaration->value));
+            pos = declaration->position;
+            continue;
+        }
+        auto result = parser.parse(pos, tokens.cend());
+        if (is_failure(result))
+        {
+            std::stringstream message;
+            message << "Failed to parse " << quote(ast::name_of_v<ast::program>);
+            return parser_failure{message.str(), tokens.cbegin(), {std::move(get_failure(result))}};
+        }
+        auto& [statement, next] = get_success(result);
+        program.statements.push_back(std::move(statement));
+        pos = next;
+    }
+    if (pos == tokens.cend())
+    {
+        return parser_failure{"Unexpected end of input while parsing repetition"};
+    }
+    return parser_success<ast::program>{std::move(program), pos + 1};
+}
+
+exceptional<ast::function, compiler_failure> parse_body(ast::function const& function)
+{
+    ast::function result = function;
+    if (!function.deferred_body)
+    {
+        return result;
+    }
+    auto const& [tokens, begin, end] = *function.deferred_body;
+    const auto stop = tokens->cbegin() + end;
+    auto body = make_parser<ast::expression>().parse(tokens->cbegin() + begin, tokens->cend());
+    if (is_failure(body))
+    {
+        return body_failure(function, get_failure(body));
+    }
+    auto& [value, next] = get_success(body);
+    if (next != stop)
+    {
+        // a function has a single body, as the parser of functions expects
+        const auto closing = make_parser<right_parenthesis_token>().parse(next, tokens->cend());
+        return body_failure(function, get_failure(closing));
+    }
+    result.body = std::move(value);
+    result.deferred_body.reset();
+    return result;
+}
+
+void lazy_functions::defer(runtime::function& value, ast::function const& function, function_meta const& meta)
+{
+    functions.emplace(&value, deferred_function{&value, function, meta.parameter_types, meta.definition});
+    deferred_count += 1;
+}
+
+std::optional<compiler_failure>
+lazy_functions::compile(compiler_environment const& env, runtime::function const* value)
+{
+    auto it = functions.find(value);
+    if (it == functions.end())
+    {
+        return std::nullopt;
+    }
+    // compiled once, calls of the function in its body are recursive
+    const deferred_function deferred = std::move(it->second);
+    functions.erase(it);
+
+    auto parsed = parse_body(deferred.function);
+    if (is_failure(parsed))
+    {
+        return std::move(get_failure(parsed));
+    }
+    const size_t hidden = first_hidden;
+    first_hidden = deferred.definition;
+    auto defined = define(env, get_success(parsed), deferred.signature, *deferred.value);
+    first_hidden = hidden;
+    if (is_failure(defined))
+    {
+        return std::move(get_failure(defined));
+    }
+    compiled_count += 1;
+    return std::nullopt;
+}
+
+bool lazy_functions::is_visible(function_meta const& meta) const
+{
+    return first_hidden == 0 || meta.definition < first_hidden;
+}
+
+size_t lazy_functions::deferred() const
+{
+    return deferred_count;
+}
+
+size_t lazy_functions::compiled() const
+{
+    return compiled_count;
+}
+
+} // namespace ant
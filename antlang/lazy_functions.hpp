@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ast.hpp"
+#include "compiler.hpp"
+#include "parser_result.hpp"
+#include "token_stream.hpp"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+
+// Parses a program without the bodies of its functions, which are found by
+// matching brackets and recorded as the deferred bodies of the functions.
+// Other statements are parsed as usual, and so are functions whose body
+// cannot be skipped, e.g. when brackets are missing, so that the failures
+// are those of parsing the whole program. The tokens must outlive the
+// program.
+parser_result<ast::program> parse_lazily(token_stream const& tokens);
+
+// The function with its deferred body parsed, or the failure of parsing it.
+exceptional<ast::function, compiler_failure> parse_body(ast::function const& function);
+
+// Functions parsed without their bodies, which are parsed and compiled when
+// the first call of them is compiled, so functions that are never called
+// are never compiled. As when they are compiled in order, bodies only see
+// the functions defined before them, and compiling a program reports the
+// failures of the bodies of called functions only. Calls of these functions
+// are not inlined, since they are compiled before the functions are.
+class lazy_functions
+{
+public:
+    // Records the declared function, whose body is compiled on first call.
+    void defer(runtime::function& value, ast::function const& function, function_meta const& meta);
+
+    // Compiles the body of the function if it is deferred.
+    std::optional<compiler_failure> compile(compiler_environment const& env, runtime::function const* value);
+
+    // Whether calls compiled now may call the function.
+    bool is_visible(function_meta const& meta) const;
+
+    // Number of functions whose body was deferred.
+    size_t deferred() const;
+
+    // Number of deferred bodies compiled so far.
+    size_t compiled() const;
+
+private:
+    struct deferred_function
+    {
+        runtime::function* value;
+        ast::function function;
+        std::vector<std::string> signature;
+        size_t definition;
+    };
+
+    std::map<runtime::function const*, deferred_function> functions;
+    // Definitions from this one on are not visible, none when 0.
+    size_t first_hidden = 0;
+    size_t deferred_count = 0;
+    size_t compiled_count = 0;
+};
+
+} // namespace ant
@@ -1,18 +1,69 @@
 #include "literal_parser.hpp"
 
+#include <algorithm>
+
 namespace ant
 {
 
-template <>
-void set_stream_locale<bool>(std::istream& in)
+bool is_below_one(std::string_view text)
 {
-    in >> std::boolalpha;
-};
+    size_t i = text.find_first_not_of("+-");
+    i = i == std::string_view::npos ? text.size() : i;
+    // decimal exponent of the first significant digit
+    long order = -1;
+    bool significant = false;
+    bool fraction = false;
+    for (; i < text.size() && text[i] != 'e' && text[i] != 'E'; ++i)
+    {
+        if (text[i] == '.')
+        {
+            fraction = true;
+        }
+        else if (!significant && text[i] == '0')
+        {
+            order -= fraction ? 1 : 0;
+        }
+        else if (!significant)
+        {
+            significant = true;
+            order = fraction ? order : 0;
+        }
+        else if (!fraction)
+        {
+            order += 1;
+        }
+    }
+    if (!significant)
+    {
+        return true;
+    }
+    long exponent = 0;
+    bool negative = false;
+    if (i + 1 < text.size() && (text[i + 1] == '-' || text[i + 1] == '+'))
+    {
+        negative = text[i + 1] == '-';
+        i += 1;
+    }
+    for (i += 1; i < text.size(); ++i)
+    {
+        // far beyond the exponents of any floating point type
+        exponent = std::min(exponent * 10 + (text[i] - '0'), 1L << 20);
+    }
+    return order + (negative ? -exponent : exponent) < 0;
+}
 
 template <>
-void set_stream_locale<bool>(std::ostream& out)
+std::optional<bool> convert_literal<bool>(std::string_view text)
 {
-    out << std::boolalpha;
-};
+    if (text == "true")
+    {
+        return true;
+    }
+    if (text == "false")
+    {
+        return false;
+    }
+    return std::nullopt;
+}
 
 }  // namespace ant
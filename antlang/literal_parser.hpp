@@ -6,55 +6,54 @@
 #include "parser.hpp"
 #include "tokens.hpp"
 
-#include <boost/lexical_cast.hpp>
-
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 namespace ant
 {
 
-template <typename T>
-void set_stream_locale(std::istream& in)
-{
-};
+// Whether the magnitude of a decimal number, with an optional exponent, is
+// below one, e.g. of a floating point literal too small to represent.
+bool is_below_one(std::string_view text);
 
+// Converts the text of a literal token to the value of a literal, or fails
+// when the text is not a value of the type, e.g. when it is out of range.
+// Floating point literals too small to represent round to zero.
 template <typename T>
-void set_stream_locale(std::ostream& out)
+std::optional<T> convert_literal(std::string_view text)
 {
-};
-
-template <>
-void set_stream_locale<bool>(std::istream& in);
-
-template <>
-void set_stream_locale<bool>(std::ostream& out);
-
-template <typename T>
-struct locale
-{
-    T value;
-
-    locale() = default;
-
-    locale(T value) : value{value} {}
-
-    operator T() const
+    static_assert(std::is_arithmetic_v<T>);
+    if (text.size() > 1 && text.front() == '+' && text[1] >= '0' && text[1] <= '9')
     {
-        return value;
+        // from_chars only accepts a leading minus sign
+        text.remove_prefix(1);
     }
-
-    friend std::ostream& operator<<(std::ostream& out, locale const& x)
+    T value{};
+    const auto [last, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (last != text.data() + text.size())
     {
-        set_stream_locale<T>(out);
-        return out << x.value;
+        return std::nullopt;
     }
-
-    friend std::istream& operator>>(std::istream& in, locale& x)
+    if constexpr (std::is_floating_point_v<T>)
     {
-        set_stream_locale<T>(in);
-        return in >> x.value;
+        if (error == std::errc::result_out_of_range && is_below_one(text))
+        {
+            return text.front() == '-' ? -T{0} : T{0};
+        }
     }
-};
+    if (error != std::errc{})
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+template <>
+std::optional<bool> convert_literal<bool>(std::string_view text);
 
 template <class Literal, class Token>
 struct parser<literal_rule<Literal, Token>>
@@ -63,8 +62,8 @@ struct parser<literal_rule<Literal, Token>>
     using value_type = typename Literal::value_type;
 
     parser_result<Literal>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         if (pos == end)
         {
@@ -72,31 +71,26 @@ struct parser<literal_rule<Literal, Token>>
             message << "Unexpected end of input while parsing token";
             throw unexpected_end_of_input_error(message.str());
         }
-        if (!holds<Token>(pos->variant))
+        if (!holds<Token>(*pos))
         {
             std::stringstream message;
             message << "Expected token " << quote(Token::name)
-                    << ", got " << quote(token_name(pos->variant));
+                    << ", got " << quote(token_name(pos->kind()));
             return parser_failure{message.str(), pos};
         }
-        const auto alternative = get<Token>(pos->variant);
+        const std::string_view text = pos->text();
         static_assert(std::is_same_v<Token, boolean_literal_token> ||
                       std::is_same_v<Token, integer_literal_token> ||
                       std::is_same_v<Token, floating_point_literal_token>);
-        try
-        {
-            return parser_success<Literal>{
-                {boost::lexical_cast<locale<value_type>>(alternative.value)},
-                pos + 1
-            };
-        }
-        catch (boost::bad_lexical_cast const& e)
+        const auto value = convert_literal<value_type>(text);
+        if (!value)
         {
             std::stringstream message;
-            message << "Literal " << quote(alternative.value)
+            message << "Literal " << quote(std::string(text))
                     << " does not fit into target type " << quote(ast::name_of_v<Literal>);
             return parser_failure{message.str(), pos};
         }
+        return parser_success<Literal>{{*value}, pos + 1};
     }
 };
 
@@ -0,0 +1,91 @@
+#include "compiler.hpp"
+
+namespace ant
+{
+
+struct expression_lowering
+{
+    lowering_scope& scope;
+
+    runtime::expression operator()(ir::constant const& expr) const
+    {
+        return expr.value;
+    }
+
+    runtime::expression operator()(ir::parameter const& expr) const
+    {
+        return expr.slot;
+    }
+
+    runtime::expression operator()(ir::local const& expr) const
+    {
+        return scope.locals.at(expr.id);
+    }
+
+    runtime::expression operator()(ir::call const& expr) const
+    {
+        return fuse(lower(scope, expr));
+    }
+
+    runtime::expression operator()(ir::condition const& expr) const
+    {
+        return fuse(lower(scope, expr));
+    }
+
+    runtime::expression operator()(ir::scope const& expr) const
+    {
+        return lower(scope, expr);
+    }
+};
+
+runtime::evaluation
+lower(lowering_scope& scope, ir::call const& expr)
+{
+    runtime::evaluation result(expr.callee);
+    std::transform(expr.arguments.begin(), expr.arguments.end(),
+                   result.arguments.begin(),
+                   [&scope](auto const& arg) { return lower(scope, arg); });
+    return result;
+}
+
+runtime::condition
+lower(lowering_scope& scope, ir::condition const& expr)
+{
+    runtime::condition result;
+    if (scope.branch_counts)
+    {
+        auto& hits = scope.branch_counts->emplace_back(expr.branches.size() + 1, 0);
+        result.hits = hits.data();
+    }
+    result.branches.reserve(expr.branches.size());
+    for (auto const& [check, value] : expr.branches)
+    {
+        result.branches.push_back({lower(scope, check), lower(scope, value)});
+    }
+    result.fallback = lower(scope, expr.fallback.get());
+    return result;
+}
+
+std::unique_ptr<runtime::scope>
+lower(lowering_scope& scope, ir::scope const& expr)
+{
+    auto result = std::make_unique<runtime::scope>();
+    result->bindings.reserve(expr.bindings.size());
+    for (auto const& binding : expr.bindings)
+    {
+        auto value = lower(scope, binding.value);
+        auto prototype = binding.prototype ? *binding.prototype : runtime::execute(value);
+        result->bindings.push_back({std::move(prototype), std::move(value)});
+        scope.locals[binding.id] = &result->bindings.back().result;
+    }
+    result->value = lower(scope, expr.value.get());
+    return result;
+}
+
+runtime::expression
+lower(lowering_scope& scope, ir::expression const& expr)
+{
+    return visit(expression_lowering{scope}, expr);
+}
+
+}  // namespace ant
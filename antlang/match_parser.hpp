@@ -6,20 +6,39 @@
 #include "tokens.hpp"
 
 #include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ant
 {
 
+template <class Rule>
+struct is_attributed_token_rule : std::false_type {};
+
+template <class Token, typename Attribute>
+struct is_attributed_token_rule<attributed_token_rule<Token, Attribute>> : std::true_type {};
+
 template <class Value, class Pattern>
 struct parser<match<Value, Pattern>>
 {
     using attribute_type = attribute_of_t<rule_of_t<Value>>;
 
     parser_result<attribute_type>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
+        if constexpr (is_attributed_token_rule<rule_of_t<Value>>::value)
+        {
+            // compare the text of the token in place, most matches fail
+            if (pos != end && holds<Value>(*pos) && pos->text() != Pattern::value)
+            {
+                std::stringstream message;
+                message << "Value " << quote(std::string(pos->text()))
+                        << " did not match the expected pattern " << quote(Pattern::value);
+                return parser_failure{message.str(), pos};
+            }
+        }
         const auto parser = make_parser<Value>();
         auto result = parser.parse(pos, end);
         if (is_success(result))
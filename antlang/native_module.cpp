@@ -0,0 +1,207 @@
+#include "native_module.hpp"
+
+#include "ast.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#if defined(_WIN32)
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+namespace ant
+{
+
+namespace
+{
+
+uint64_t fnv1a(std::string const& data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string shell_quote(std::string const& x)
+{
+    std::string result = "'";
+    for (char c : x)
+    {
+        result += (c == '\'') ? std::string("'\\''") : std::string(1, c);
+    }
+    return result + "'";
+}
+
+template <typename T>
+bool read_value(std::string const& type, void const* data, runtime::value_variant& result)
+{
+    if (type != ast::name_of_v<ast::literal<T>>)
+    {
+        return false;
+    }
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    result = value;
+    return true;
+}
+
+template <typename... Ts>
+runtime::value_variant read_value(std::string const& type, void const* data)
+{
+    runtime::value_variant result;
+    if (!(read_value<Ts>(type, data, result) || ...))
+    {
+        throw std::invalid_argument("native evaluation of unsupported type " + type);
+    }
+    return result;
+}
+
+} // namespace
+
+native_module::native_module(void* handle, std::vector<native_evaluation> evaluations)
+    : handle{handle}
+    , evaluations(std::move(evaluations))
+{
+}
+
+native_module::native_module(native_module&& that)
+    : handle{std::exchange(that.handle, nullptr)}
+    , evaluations(std::move(that.evaluations))
+{
+}
+
+native_module::~native_module()
+{
+#if !defined(_WIN32)
+    if (handle)
+    {
+        dlclose(handle);
+    }
+#endif
+}
+
+size_t native_module::size() const
+{
+    return evaluations.size();
+}
+
+runtime::value_variant native_module::execute(size_t index) const
+{
+    auto const& eval = evaluations.at(index);
+    alignas(uint64_t) unsigned char result[sizeof(uint64_t)];
+    if (eval.function(result) != 0)
+    {
+        throw runtime::arithmetic_error("division by zero");
+    }
+    return read_value<
+        bool,
+        int8_t,  int16_t,  int32_t,  int64_t,
+        uint8_t, uint16_t, uint32_t, uint64_t,
+        flt32_t, flt64_t
+    >(eval.type, result);
+}
+
+std::string default_native_cache_directory()
+{
+    namespace fs = std::filesystem;
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"))
+    {
+        return (fs::path(cache) / "antlang").string();
+    }
+    if (const char* home = std::getenv("HOME"))
+    {
+        return (fs::path(home) / ".cache" / "antlang").string();
+    }
+    return (fs::temp_directory_path() / "antlang").string();
+}
+
+exceptional<native_module, std::string>
+load_native_module(std::string const& c_source,
+                   std::string const& cache_directory)
+{
+#if defined(_WIN32)
+    return std::string("Native modules are not supported on this platform");
+#else
+    namespace fs = std::filesystem;
+
+    const char* cc = std::getenv("CC");
+    const std::string compiler = cc ? cc : "cc";
+    const std::string flags = "-std=c99 -O2 -shared -fPIC";
+
+    std::stringstream hash;
+    hash << std::hex << std::setw(16) << std::setfill('0')
+         << fnv1a(compiler + '\n' + flags + '\n' + c_source);
+
+    const fs::path directory(cache_directory);
+    const fs::path object = directory / (hash.str() + ".so");
+
+    if (!fs::exists(object))
+    {
+        std::error_code error;
+        fs::create_directories(directory, error);
+        if (error)
+        {
+            return "Could not create cache directory " + directory.string() + ": " + error.message();
+        }
+        const fs::path source = directory / (hash.str() + ".c");
+        const fs::path log = directory / (hash.str() + ".log");
+        const fs::path temporary = directory / (hash.str() + ".so." + std::to_string(getpid()));
+        std::ofstream(source) << c_source;
+        const std::string command =
+            compiler + " " + flags + " -o " + shell_quote(temporary.string()) + " "
+            + shell_quote(source.string()) + " > " + shell_quote(log.string()) + " 2>&1";
+        if (std::system(command.c_str()) != 0)
+        {
+            return "C compiler " + compiler + " failed, see " + log.string();
+        }
+        fs::rename(temporary, object, error);
+        if (error)
+        {
+            return "Could not cache " + object.string() + ": " + error.message();
+        }
+    }
+
+    void* handle = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+    {
+        return std::string("Could not load native module: ") + dlerror();
+    }
+
+    auto* count = static_cast<size_t const*>(dlsym(handle, "ant_eval_count"));
+    auto* types = static_cast<char const* const*>(dlsym(handle, "ant_eval_types"));
+    if (!count || !types)
+    {
+        dlclose(handle);
+        return "Native module " + object.string() + " is missing its evaluation tables";
+    }
+
+    std::vector<native_evaluation> evaluations;
+    evaluations.reserve(*count);
+    for (size_t i = 0; i < *count; ++i)
+    {
+        const std::string name = "ant_eval_" + std::to_string(i);
+        void* symbol = dlsym(handle, name.c_str());
+        if (!symbol)
+        {
+            dlclose(handle);
+            return "Native module " + object.string() + " is missing " + name;
+        }
+        evaluations.push_back({reinterpret_cast<int (*)(void*)>(symbol), types[i]});
+    }
+
+    return native_module(handle, std::move(evaluations));
+#endif
+}
+
+} // namespace ant
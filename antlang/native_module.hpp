@@ -0,0 +1,50 @@
+#pragma once
+
+#include "exceptional.hpp"
+#include "runtime.hpp"
+
+#include <string>
+#include <vector>
+
+namespace ant
+{
+
+struct native_evaluation
+{
+    int (*function)(void* result);
+    std::string type;
+};
+
+// A shared object compiled from the output of emit_c, see c_emitter.hpp.
+class native_module
+{
+public:
+    native_module(void* handle, std::vector<native_evaluation> evaluations);
+
+    native_module(native_module&& that);
+
+    native_module(native_module const&) = delete;
+
+    native_module& operator=(native_module const&) = delete;
+
+    ~native_module();
+
+    size_t size() const;
+
+    // Throws runtime::arithmetic_error like the runtime does.
+    runtime::value_variant execute(size_t index) const;
+
+private:
+    void* handle;
+    std::vector<native_evaluation> evaluations;
+};
+
+std::string default_native_cache_directory();
+
+// Compiles the C source with the system C compiler, $CC or cc, unless a
+// shared object for the same source is already cached, and loads it.
+exceptional<native_module, std::string>
+load_native_module(std::string const& c_source,
+                   std::string const& cache_directory);
+
+} // namespace ant
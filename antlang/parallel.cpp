@@ -0,0 +1,59 @@
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ant
+{
+
+size_t hardware_threads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void parallel_for(size_t count, size_t threads, std::function<void(size_t)> const& task)
+{
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+    const auto work = [&] {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+                // leave the remaining tasks
+                next = count;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    const size_t helpers = std::min(threads, count);
+    for (size_t i = 1; i < helpers; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace ant
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace ant
+{
+
+// Number of threads the processor runs at once, at least one.
+size_t hardware_threads();
+
+// Runs the task for every index below count on up to the given number of
+// threads, the calling one included. Threads take the next index when done
+// with one, so tasks of uneven sizes are spread over them. The first
+// exception thrown by a task is rethrown once all threads are done.
+void parallel_for(size_t count, size_t threads, std::function<void(size_t)> const& task);
+
+} // namespace ant
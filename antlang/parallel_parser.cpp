@@ -0,0 +1,111 @@
+#include "parallel_parser.hpp"
+
+#include "formatting.hpp"
+#include "parallel.hpp"
+#include "parser.hpp"
+
+#include <optional>
+#include <sstream>
+#include <utility>
+
+namespace ant
+{
+
+namespace
+{
+
+// Fewest tokens parsed by a thread of its own.
+constexpr size_t min_parallel_tokens = 1 << 14;
+
+// Parts per thread, so that threads done with short parts take more.
+constexpr size_t parts_per_thread = 4;
+
+struct parsed_part
+{
+    std::vector<ast::statement> statements;
+    std::optional<parser_failure> failure;
+};
+
+parsed_part parse_part(token_stream const& tokens, size_t begin, size_t end)
+{
+    const auto parser = make_parser<ast::statement>();
+    parsed_part part;
+    auto pos = tokens.cbegin() + begin;
+    const auto stop = tokens.cbegin() + end;
+    while (pos < stop)
+    {
+        // the end of input keeps the parser from running out of tokens on
+        // malformed statements
+        auto result = parser.parse(pos, tokens.cend());
+        if (is_failure(result))
+        {
+            part.failure = std::move(get_failure(result));
+            break;
+        }
+        auto& [statement, next] = get_success(result);
+        part.statements.push_back(std::move(statement));
+        pos = next;
+    }
+    return part;
+}
+
+} // namespace
+
+std::vector<size_t> split_at_statements(token_stream const& tokens, size_t parts)
+{
+    const size_t count = tokens.empty() ? 0 : tokens.size() - 1;
+    std::vector<size_t> boundaries = {0};
+    long depth = 0;
+    for (size_t i = 0; i < count && boundaries.size() < parts; ++i)
+    {
+        if (depth == 0 && i > boundaries.back() && i >= boundaries.size() * count / parts)
+        {
+            boundaries.push_back(i);
+        }
+        const auto kind = tokens.kind(i);
+        if (kind == token_kind_of_v<left_parenthesis_token> ||
+            kind == token_kind_of_v<left_bracket_token>)
+        {
+            depth += 1;
+        }
+        else if (kind == token_kind_of_v<right_parenthesis_token> ||
+                 kind == token_kind_of_v<right_bracket_token>)
+        {
+            // closing brackets without an opening one end no statement
+            depth = std::max(depth - 1, 0L);
+        }
+    }
+    boundaries.push_back(count);
+    return boundaries;
+}
+
+parser_result<ast::program> parse_program(token_stream const& tokens, size_t threads)
+{
+    const size_t parts = std::min(threads * parts_per_thread, tokens.size() / min_parallel_tokens + 1);
+    if (threads <= 1 || parts <= 1)
+    {
+        return make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    }
+    const std::vector<size_t> boundaries = split_at_statements(tokens, parts);
+    std::vector<parsed_part> parsed(boundaries.size() - 1);
+    parallel_for(parsed.size(), threads, [&](size_t i) {
+        parsed[i] = parse_part(tokens, boundaries[i], boundaries[i + 1]);
+    });
+    ast::program program;
+    for (auto& part : parsed)
+    {
+        if (part.failure)
+        {
+            std::stringstream message;
+            message << "Failed to parse " << quote(ast::name_of_v<ast::program>);
+            return parser_failure{message.str(), tokens.cbegin(), {std::move(*part.failure)}};
+        }
+        for (auto& statement : part.statements)
+        {
+            program.statements.push_back(std::move(statement));
+        }
+    }
+    return parser_success<ast::program>{std::move(program), tokens.cend()};
+}
+
+} // namespace ant
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ast.hpp"
+#include "parser_result.hpp"
+#include "token_stream.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace ant
+{
+
+// Splits the tokens of a program, without the end of input, into at most
+// the given number of parts of about the same size, starting at tokens
+// outside of brackets. Returns the indices of the parts from 0 to the end
+// of input token.
+std::vector<size_t> split_at_statements(token_stream const& tokens, size_t parts);
+
+// Parses a program on up to the given number of threads. The statements of
+// every part of the tokens, see split_at_statements, are parsed on their
+// own and joined in order. Fails as parsing the program on a single thread
+// does, with the failure of the earliest statement that fails.
+parser_result<ast::program> parse_program(token_stream const& tokens, size_t threads);
+
+} // namespace ant
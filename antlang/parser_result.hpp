@@ -1,7 +1,7 @@
 #pragma once
 
 #include "exceptional.hpp"
-#include "tokens.hpp"
+#include "token_stream.hpp"
 
 #include <vector>
 
@@ -12,13 +12,13 @@ template <typename Attribute>
 struct parser_success
 {
     Attribute value;
-    std::vector<token>::const_iterator position;
+    token_iterator position;
 };
 
 struct parser_failure
 {
     std::string message;
-    std::vector<token>::const_iterator position;
+    token_iterator position;
     std::vector<parser_failure> children;
 };
 
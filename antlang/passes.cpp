@@ -0,0 +1,99 @@
+#include "passes.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace ant
+{
+
+std::vector<optimization_pass> const& optimization_passes()
+{
+    static const std::vector<optimization_pass> passes = {
+        {"inline", 2, inline_calls},
+        {"fold", 1, fold_constants},
+        {"dead-branches", 1, eliminate_dead_branches},
+        {"reorder-branches", 1, reorder_branches},
+    };
+    return passes;
+}
+
+std::optional<optimization_pass> find_pass(std::string const& name)
+{
+    auto const& passes = optimization_passes();
+    auto it = std::find_if(passes.begin(), passes.end(),
+                           [&name](auto const& pass) { return pass.name == name; });
+    if (it == passes.end())
+    {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+pass_manager make_pass_manager(int level)
+{
+    pass_manager manager;
+    for (auto const& pass : optimization_passes())
+    {
+        if (pass.level <= level)
+        {
+            manager.pipeline.push_back(pass);
+            manager.timings.push_back({pass.name});
+        }
+    }
+    return manager;
+}
+
+void run_passes(pass_manager& manager,
+                compiler_environment const& env,
+                ir::function& func)
+{
+    for (size_t i = 0; i < manager.pipeline.size(); ++i)
+    {
+        auto const& pass = manager.pipeline.at(i);
+        const auto start = std::chrono::steady_clock::now();
+        pass.run(env, func);
+        auto& timing = manager.timings.at(i);
+        timing.elapsed += std::chrono::steady_clock::now() - start;
+        timing.runs += 1;
+        if (manager.dump && manager.dump_after == pass.name)
+        {
+            *manager.dump << "; ir after " << pass.name << '\n';
+            print(*manager.dump, func);
+        }
+    }
+}
+
+std::string profile_key(ir::function const& func)
+{
+    std::vector<std::string> signature;
+    for (auto const& param : func.parameters)
+    {
+        signature.push_back(param.type);
+    }
+    return profile_key(func.name, signature);
+}
+
+void print_timings(std::ostream& out, pass_manager const& manager)
+{
+    std::chrono::nanoseconds total{0};
+    size_t total_runs = 0;
+    for (auto const& timing : manager.timings)
+    {
+        total += timing.elapsed;
+        total_runs += timing.runs;
+    }
+    auto print_row = [&out](std::string const& name, std::chrono::nanoseconds elapsed, size_t runs)
+    {
+        const auto microseconds = std::chrono::duration<double, std::micro>(elapsed).count();
+        out << std::setw(12) << std::fixed << std::setprecision(1) << microseconds << "us "
+            << std::setw(8) << runs << ' ' << name << '\n';
+    };
+    out << std::setw(14) << "time" << ' ' << std::setw(8) << "runs" << " pass\n";
+    for (auto const& timing : manager.timings)
+    {
+        print_row(timing.name, timing.elapsed, timing.runs);
+    }
+    print_row("total", total, total_runs);
+}
+
+}  // namespace ant
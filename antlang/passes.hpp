@@ -0,0 +1,86 @@
+#pragma once
+
+#include "compiler.hpp"
+#include "ir.hpp"
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+
+using pass_function = void (*)(compiler_environment const& env, ir::function& func);
+
+struct optimization_pass
+{
+    std::string name;
+    // Lowest optimization level running the pass.
+    int level;
+    pass_function run;
+};
+
+struct pass_timing
+{
+    std::string name;
+    std::chrono::nanoseconds elapsed{0};
+    size_t runs = 0;
+};
+
+// The passes selected for an optimization level, run in order on the ir of
+// every compiled function and evaluation.
+struct pass_manager
+{
+    std::vector<optimization_pass> pipeline;
+    std::vector<pass_timing> timings;
+    std::optional<std::string> dump_after;
+    std::ostream* dump = nullptr;
+};
+
+constexpr int max_optimization_level = 2;
+
+// All passes in pipeline order.
+std::vector<optimization_pass> const& optimization_passes();
+
+std::optional<optimization_pass> find_pass(std::string const& name);
+
+pass_manager make_pass_manager(int level);
+
+void run_passes(pass_manager& manager,
+                compiler_environment const& env,
+                ir::function& func);
+
+void print_timings(std::ostream& out, pass_manager const& manager);
+
+// Key of the function in branch and call profiles.
+std::string profile_key(ir::function const& func);
+
+// Replaces calls of built-in operations on constants by their result.
+void fold_constants(compiler_environment const& env, ir::function& func);
+
+// Largest function body, in ir nodes, substituted at its call sites.
+constexpr size_t inline_size_limit = 12;
+
+size_t count_nodes(ir::expression const& expr);
+
+// Small non-recursive functions are inlinable, the decision is recorded in
+// the function meta and reported by find_function. With a recorded profile,
+// functions never called are not inlined and hot functions may be twice as
+// large.
+inlining_decision decide_inlining(compiler_environment const& env, ir::function const& func);
+
+// Replaces calls of inlinable functions by their body.
+void inline_calls(compiler_environment const& env, ir::function& func);
+
+// Removes condition branches with constant checks.
+void eliminate_dead_branches(compiler_environment const& env, ir::function& func);
+
+// Moves the most frequently taken branches of a condition first, following
+// the branch profile of the environment. Only conditions whose checks are
+// comparisons of the same value with disjoint constant ranges are
+// reordered, since at most one of their checks holds.
+void reorder_branches(compiler_environment const& env, ir::function& func);
+
+}  // namespace ant
@@ -0,0 +1,140 @@
+#include "profile.hpp"
+
+#include <sstream>
+
+namespace ant
+{
+
+namespace
+{
+
+constexpr const char* profile_header = "antlang-profile";
+constexpr int profile_version = 1;
+
+// Reads a key written by profile_key, whose signature may contain spaces.
+bool read_key(std::istream& in, std::string& key)
+{
+    std::string word;
+    if (!(in >> key))
+    {
+        return false;
+    }
+    while (key.back() != ')')
+    {
+        if (!(in >> word))
+        {
+            return false;
+        }
+        key += ' ' + word;
+    }
+    return key.find('(') != std::string::npos;
+}
+
+bool expect_word(std::istream& in, std::string const& expected)
+{
+    std::string word;
+    return in >> word && word == expected;
+}
+
+}  // namespace
+
+program_profile make_profile(runtime::profiler const& profiler,
+                             branch_profile const& branches)
+{
+    program_profile result;
+    for (auto const& [key, profile] : profiler.functions)
+    {
+        result.functions[key] = {profile.calls, profile.inclusive};
+    }
+    result.branches.functions = branches.functions;
+    return result;
+}
+
+void write_profile(std::ostream& out, program_profile const& profile)
+{
+    out << profile_header << ' ' << profile_version << '\n';
+    for (auto const& [key, record] : profile.functions)
+    {
+        out << "function " << key
+            << " calls " << record.calls
+            << " inclusive-ns " << record.inclusive.count() << '\n';
+    }
+    for (auto const& [key, conditions] : profile.branches.functions)
+    {
+        for (size_t i = 0; i < conditions.size(); ++i)
+        {
+            out << "condition " << key << ' ' << i << " hits";
+            for (auto hits : conditions.at(i))
+            {
+                out << ' ' << hits;
+            }
+            out << '\n';
+        }
+    }
+}
+
+exceptional<program_profile, std::string> read_profile(std::istream& in)
+{
+    std::string line;
+    if (!std::getline(in, line) ||
+        line != profile_header + (' ' + std::to_string(profile_version)))
+    {
+        return std::string("Not an antlang profile of version ") + std::to_string(profile_version);
+    }
+    program_profile result;
+    size_t line_number = 1;
+    while (std::getline(in, line))
+    {
+        line_number += 1;
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind))
+        {
+            continue;
+        }
+        std::string key;
+        bool valid = read_key(fields, key);
+        if (valid && kind == "function")
+        {
+            call_record record;
+            int64_t inclusive = 0;
+            valid = expect_word(fields, "calls") && fields >> record.calls &&
+                    expect_word(fields, "inclusive-ns") && fields >> inclusive;
+            record.inclusive = std::chrono::nanoseconds(inclusive);
+            result.functions[key] = record;
+        }
+        else if (valid && kind == "condition")
+        {
+            size_t index = 0;
+            valid = fields >> index && expect_word(fields, "hits");
+            branch_hits hits;
+            uint64_t count = 0;
+            while (valid && fields >> count)
+            {
+                hits.push_back(count);
+            }
+            valid = valid && fields.eof() && !hits.empty();
+            auto& conditions = result.branches.functions[key];
+            if (valid && conditions.size() <= index)
+            {
+                conditions.resize(index + 1);
+            }
+            if (valid)
+            {
+                conditions.at(index) = std::move(hits);
+            }
+        }
+        else
+        {
+            valid = false;
+        }
+        std::string rest;
+        if (!valid || fields >> rest)
+        {
+            return "Invalid profile line " + std::to_string(line_number) + ": " + line;
+        }
+    }
+    return result;
+}
+
+}  // namespace ant
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "branch_profile.hpp"
+#include "exceptional.hpp"
+#include "profiler.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace ant
+{
+
+struct call_record
+{
+    uint64_t calls = 0;
+    std::chrono::nanoseconds inclusive{0};
+};
+
+// Recorded run of a program guiding the compilation of later runs. Entries
+// are keyed by profile_key, so that functions survive unrelated edits of
+// the program, and functions missing from the profile compile as without.
+struct program_profile
+{
+    std::map<std::string, call_record> functions;
+    branch_profile branches;
+};
+
+// Functions called at least this often in a profile are hot.
+constexpr uint64_t hot_call_count = 1000;
+
+program_profile make_profile(runtime::profiler const& profiler,
+                             branch_profile const& branches);
+
+// Writes the profile as text, one function or condition per line:
+//
+//     antlang-profile 1
+//     function fib(i32) calls 177 inclusive-ns 48213
+//     condition fib(i32) 0 hits 1 88 88
+void write_profile(std::ostream& out, program_profile const& profile);
+
+exceptional<program_profile, std::string> read_profile(std::istream& in);
+
+}  // namespace ant
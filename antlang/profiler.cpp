@@ -0,0 +1,127 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace ant
+{
+namespace runtime
+{
+
+namespace
+{
+
+size_t enter_stack(std::vector<call_stack>& stacks, size_t parent, function_profile const& profile)
+{
+    for (size_t child : stacks[parent].children)
+    {
+        if (stacks[child].profile == &profile)
+        {
+            return child;
+        }
+    }
+    stacks.push_back({&profile, parent});
+    stacks[parent].children.push_back(stacks.size() - 1);
+    return stacks.size() - 1;
+}
+
+}  // namespace
+
+profiled_call::profiled_call(profiler& owner, function_profile& profile)
+    : owner{owner}
+{
+    ++profile.calls;
+    ++profile.depth;
+    const size_t parent = owner.frames.empty() ? 0 : owner.frames.back().stack;
+    const size_t stack = enter_stack(owner.stacks, parent, profile);
+    owner.frames.push_back({&profile, stack, profiler_clock::now()});
+}
+
+profiled_call::~profiled_call()
+{
+    const auto frame = owner.frames.back();
+    owner.frames.pop_back();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        profiler_clock::now() - frame.start);
+    auto& profile = *frame.profile;
+    profile.exclusive += elapsed - frame.callees;
+    owner.stacks[frame.stack].exclusive += elapsed - frame.callees;
+    if (--profile.depth == 0)
+    {
+        profile.inclusive += elapsed;
+    }
+    if (!owner.frames.empty())
+    {
+        owner.frames.back().callees += elapsed;
+    }
+}
+
+void print_profile(std::ostream& out, profiler const& profiler)
+{
+    std::vector<std::pair<std::string, function_profile>> entries;
+    for (auto const& [key, profile] : profiler.functions)
+    {
+        if (profile.calls > 0)
+        {
+            entries.emplace_back(key, profile);
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](auto const& lhs, auto const& rhs)
+                     {
+                         return lhs.second.exclusive > rhs.second.exclusive;
+                     });
+    auto microseconds = [](std::chrono::nanoseconds elapsed)
+    {
+        return std::chrono::duration<double, std::micro>(elapsed).count();
+    };
+    out << std::setw(12) << "calls" << ' ' << std::setw(14) << "inclusive"
+        << ' ' << std::setw(14) << "exclusive" << " function\n";
+    for (auto const& [key, profile] : entries)
+    {
+        out << std::setw(12) << profile.calls << ' '
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << microseconds(profile.inclusive) << "us "
+            << std::setw(12) << microseconds(profile.exclusive) << "us "
+            << key << '\n';
+    }
+}
+
+void write_folded_stacks(std::ostream& out, profiler const& profiler)
+{
+    std::map<function_profile const*, std::string> names;
+    for (auto const& [key, profile] : profiler.functions)
+    {
+        names[&profile] = key;
+    }
+    auto const& stacks = profiler.stacks;
+    // depth first, with the path of every pending stack
+    std::vector<std::pair<size_t, std::string>> pending;
+    for (auto it = stacks.front().children.rbegin(); it != stacks.front().children.rend(); ++it)
+    {
+        pending.emplace_back(*it, names.at(stacks[*it].profile));
+    }
+    while (!pending.empty())
+    {
+        auto [index, path] = std::move(pending.back());
+        pending.pop_back();
+        auto const& stack = stacks[index];
+        if (stack.exclusive.count() > 0)
+        {
+            out << path << ' ' << stack.exclusive.count() << '\n';
+        }
+        for (auto it = stack.children.rbegin(); it != stack.children.rend(); ++it)
+        {
+            pending.emplace_back(*it, path + ';' + names.at(stacks[*it].profile));
+        }
+    }
+}
+
+value_variant execute(probe& expr)
+{
+    profiled_call call(*expr.owner, *expr.profile);
+    return execute(expr.value);
+}
+
+}  // namespace runtime
+}  // namespace ant
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "runtime.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+namespace runtime
+{
+
+using profiler_clock = std::chrono::steady_clock;
+
+struct function_profile
+{
+    uint64_t calls = 0;
+    // Time from entering the outermost activation of the function until
+    // leaving it, recursive activations are not counted twice.
+    std::chrono::nanoseconds inclusive{0};
+    // Time spent in the function itself, excluding profiled callees.
+    std::chrono::nanoseconds exclusive{0};
+    // Activations of the function on the call stack.
+    size_t depth = 0;
+};
+
+// A distinct stack of profiled calls, its parent is the stack without the
+// last call.
+struct call_stack
+{
+    function_profile const* profile = nullptr;
+    size_t parent = 0;
+    std::chrono::nanoseconds exclusive{0};
+    std::vector<size_t> children;
+};
+
+struct profiler_frame
+{
+    function_profile* profile;
+    size_t stack;
+    profiler_clock::time_point start;
+    std::chrono::nanoseconds callees{0};
+};
+
+// Calls and time of the functions compiled while set in the compiler
+// environment, keyed by profile_key. Their bodies are wrapped in probes,
+// leaving functions compiled without a profiler untouched.
+struct profiler
+{
+    std::map<std::string, function_profile> functions;
+    std::vector<profiler_frame> frames;
+    // The exclusive time of every call stack seen, the first being empty.
+    std::vector<call_stack> stacks = std::vector<call_stack>(1);
+};
+
+// Enters a frame for a call of a profiled function and leaves it when
+// destroyed, also when the call throws.
+class profiled_call
+{
+public:
+    profiled_call(profiler& owner, function_profile& profile);
+
+    profiled_call(profiled_call const&) = delete;
+
+    profiled_call& operator=(profiled_call const&) = delete;
+
+    ~profiled_call();
+
+private:
+    profiler& owner;
+};
+
+// Prints the calls, inclusive and exclusive time of the called functions,
+// the most expensive first.
+void print_profile(std::ostream& out, profiler const& profiler);
+
+// Writes the exclusive time in nanoseconds of every call stack in the folded
+// format of flame graph tools, e.g. "fib(i32);fib(i32) 1234".
+void write_folded_stacks(std::ostream& out, profiler const& profiler);
+
+}  // namespace runtime
+}  // namespace ant
@@ -0,0 +1,202 @@
+#include "program_generator.hpp"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace ant
+{
+
+namespace
+{
+
+const char* const type_names[fundamental_type_count] = {
+    "i32", "i64", "f64", "u32", "u16", "i16", "u64", "f32", "u8", "i8", "bool"
+};
+
+class program_writer
+{
+public:
+    program_writer(generator_options const& options)
+        : options{options}
+        , random{options.seed}
+    {
+    }
+
+    std::string write()
+    {
+        out << ";; generated with seed " << options.seed << ", " << options.functions
+            << " functions of " << overloads() << " overloads\n";
+        for (size_t i = 0; i < options.functions; ++i)
+        {
+            for (size_t k = 0; k < overloads(); ++k)
+            {
+                write_function(i, type_names[k]);
+            }
+        }
+        for (size_t i = 0; options.functions > 0 && i < options.evaluations; ++i)
+        {
+            const std::string type = type_names[pick(overloads())];
+            out << "(g" << pick(options.functions);
+            for (size_t p = 0; p < options.parameters; ++p)
+            {
+                out << ' ' << literal(type);
+            }
+            out << ")\n";
+        }
+        return out.str();
+    }
+
+private:
+    generator_options const& options;
+    // std::uniform_int_distribution differs between standard libraries
+    std::mt19937_64 random;
+    std::stringstream out;
+    std::vector<std::string> operands;
+    size_t next_local = 0;
+
+    size_t overloads() const
+    {
+        return std::min(options.overloads, fundamental_type_count);
+    }
+
+    size_t pick(size_t count)
+    {
+        return random() % count;
+    }
+
+    std::string literal(std::string const& type)
+    {
+        if (type == "bool")
+        {
+            return pick(2) ? "true" : "false";
+        }
+        std::string value = std::to_string(pick(10));
+        if (type.front() == 'f')
+        {
+            value += ".5";
+        }
+        return "(" + type + " " + value + ")";
+    }
+
+    std::string operand(std::string const& type)
+    {
+        if (operands.empty() || pick(4) == 0)
+        {
+            return literal(type);
+        }
+        return operands.at(pick(operands.size()));
+    }
+
+    void indent(size_t level)
+    {
+        out << std::string(2 * level, ' ');
+    }
+
+    void write_expression(std::string const& type, size_t depth, size_t level)
+    {
+        const bool arithmetic = type != "bool";
+        if (depth == 0)
+        {
+            out << operand(type);
+            return;
+        }
+        switch (pick(3))
+        {
+        case 0:
+        {
+            const std::string name = "a" + std::to_string(next_local++);
+            out << "(let [" << name << ' ';
+            if (arithmetic)
+            {
+                out << '(' << (pick(2) ? '+' : '-') << ' ' << operand(type) << ' ' << operand(type) << ')';
+            }
+            else
+            {
+                out << operand(type);
+            }
+            out << "]\n";
+            operands.push_back(name);
+            indent(level + 1);
+            write_expression(type, depth - 1, level + 1);
+            operands.pop_back();
+            out << ')';
+            break;
+        }
+        case 1:
+        {
+            static const char* const comparisons[] = {"<", "=", ">", "<=", ">=", "!="};
+            out << "(when [";
+            if (arithmetic)
+            {
+                out << '(' << comparisons[pick(6)] << ' ' << operand(type) << ' ' << operand(type) << ')';
+            }
+            else
+            {
+                out << operand(type);
+            }
+            out << ' ' << operand(type) << "]\n";
+            indent(level + 3);
+            write_expression(type, depth - 1, level + 3);
+            out << ')';
+            break;
+        }
+        default:
+        {
+            if (!arithmetic)
+            {
+                write_expression(type, depth - 1, level);
+                break;
+            }
+            out << '(' << (pick(2) ? '+' : '-') << ' ' << operand(type) << '\n';
+            indent(level + 1);
+            write_expression(type, depth - 1, level + 1);
+            out << ')';
+            break;
+        }
+        }
+    }
+
+    void write_function(size_t index, std::string const& type)
+    {
+        operands.clear();
+        next_local = 0;
+        out << "(function g" << index << ' ' << type << " (";
+        for (size_t p = 0; p < options.parameters; ++p)
+        {
+            const std::string name = "p" + std::to_string(p);
+            out << (p == 0 ? "" : " ") << type << ' ' << name;
+            operands.push_back(name);
+        }
+        out << ")\n";
+        indent(1);
+        if (index > 0)
+        {
+            out << "(let [c (g" << (index - 1) / 2;
+            for (size_t p = 0; p < options.parameters; ++p)
+            {
+                out << ' ' << operand(type);
+            }
+            out << ")]\n";
+            operands.push_back("c");
+            indent(2);
+            write_expression(type, options.depth, 2);
+            out << ')';
+        }
+        else
+        {
+            write_expression(type, options.depth, 1);
+        }
+        out << ")\n\n";
+    }
+};
+
+}  // namespace
+
+std::string generate_program(generator_options const& options)
+{
+    return program_writer{options}.write();
+}
+
+}  // namespace ant
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ant
+{
+
+// Shape of a synthetic program used to test how the compiler scales.
+struct generator_options
+{
+    uint64_t seed = 1;
+    // Distinct function names, each defined once per overload.
+    size_t functions = 100;
+    // Overloads of every function, one per fundamental type, at most 11.
+    size_t overloads = 3;
+    // Nesting of let, when and operations in every function body.
+    size_t depth = 4;
+    size_t parameters = 2;
+    size_t evaluations = 100;
+};
+
+constexpr size_t fundamental_type_count = 11;
+
+// Generates the same program for the same options. Function i calls
+// function (i - 1) / 2 of the same overload, so evaluations stay cheap while
+// every function takes part in overload resolution.
+std::string generate_program(generator_options const& options);
+
+}  // namespace ant
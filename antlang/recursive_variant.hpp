@@ -1,92 +1,304 @@
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <new>
 #include <variant>
 #include <type_traits>
 
 namespace ant
 {
 
+// Free lists of the nodes of recursive wrappers, one per type and thread,
+// so that trees built and torn down repeatedly reuse their nodes.
+template <typename T>
+class node_pool
+{
+public:
+    static constexpr size_t max_free_nodes = 4096;
+
+    static void* allocate()
+    {
+        if (!torn_down)
+        {
+            auto& pool = instance();
+            if (pool.free)
+            {
+                node* result = pool.free;
+                pool.free = result->next;
+                --pool.free_count;
+                return result;
+            }
+        }
+        return ::operator new(sizeof(node));
+    }
+
+    static void deallocate(void* pointer) noexcept
+    {
+        if (!torn_down)
+        {
+            auto& pool = instance();
+            if (pool.free_count < max_free_nodes)
+            {
+                auto* freed = static_cast<node*>(pointer);
+                freed->next = pool.free;
+                pool.free = freed;
+                ++pool.free_count;
+                return;
+            }
+        }
+        ::operator delete(pointer);
+    }
+
+private:
+    union node
+    {
+        node* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    node* free = nullptr;
+    size_t free_count = 0;
+
+    // Nodes may outlive the pool of their thread, e.g. in static objects.
+    static inline thread_local bool torn_down = false;
+
+    ~node_pool()
+    {
+        torn_down = true;
+        while (free)
+        {
+            node* next = free->next;
+            ::operator delete(free);
+            free = next;
+        }
+    }
+
+    static node_pool& instance()
+    {
+        static thread_local node_pool pool;
+        return pool;
+    }
+};
+
+template <typename T>
+struct node_deleter
+{
+    void operator()(T* pointer) const noexcept
+    {
+        pointer->~T();
+        node_pool<T>::deallocate(pointer);
+    }
+};
+
+template <typename T>
+using node_pointer = std::unique_ptr<T, node_deleter<T>>;
+
+template <typename T, typename... Args>
+node_pointer<T> make_node(Args&&... args)
+{
+    void* memory = node_pool<T>::allocate();
+    try
+    {
+        return node_pointer<T>(new (memory) T(std::forward<Args>(args)...));
+    }
+    catch (...)
+    {
+        node_pool<T>::deallocate(memory);
+        throw;
+    }
+}
+
+// Owns a T on the heap, to let a type contain itself through a variant.
+// Copies copy the T, while moves steal it and leave the moved from wrapper
+// empty, only fit to be destroyed or assigned to.
 template <typename T>
 class recursive_wrapper
 {
 private:
-    std::unique_ptr<T> value;
+    node_pointer<T> value;
 public:
-    constexpr recursive_wrapper()
-        : value{std::make_unique<T>()} {}
+    recursive_wrapper()
+        : value{make_node<T>()} {}
 
-    constexpr recursive_wrapper(T const& value)
-        : value{std::make_unique<T>(value)} {}
+    recursive_wrapper(T const& value)
+        : value{make_node<T>(value)} {}
 
-    constexpr recursive_wrapper(T&& value)
-        : value{std::make_unique<T>(std::move(value))} {}
+    recursive_wrapper(T&& value)
+        : value{make_node<T>(std::move(value))} {}
 
-    constexpr recursive_wrapper(recursive_wrapper const& that)
-        : recursive_wrapper(*that.value) {}
+    recursive_wrapper(recursive_wrapper const& that)
+        : value{that.value ? make_node<T>(*that.value) : nullptr} {}
 
-    constexpr recursive_wrapper(recursive_wrapper&& that)
-        : recursive_wrapper(std::move(*that.value)) {}
+    recursive_wrapper(recursive_wrapper&& that) noexcept
+        : value{std::move(that.value)} {}
 
     ~recursive_wrapper() = default;
 
-    constexpr recursive_wrapper&
+    recursive_wrapper&
     operator=(T const& value) &
     {
-        *this->value = value;
+        if (this->value)
+        {
+            *this->value = value;
+        }
+        else
+        {
+            // moved from
+            this->value = make_node<T>(value);
+        }
         return *this;
     }
 
-    constexpr recursive_wrapper&
+    recursive_wrapper&
     operator=(T&& value) &
     {
-        *this->value = std::move(value);
+        if (this->value)
+        {
+            *this->value = std::move(value);
+        }
+        else
+        {
+            // moved from
+            this->value = make_node<T>(std::move(value));
+        }
         return *this;
     }
 
-    constexpr recursive_wrapper&
+    recursive_wrapper&
     operator=(recursive_wrapper const& that) &
     {
-        *this->value = *that.value;
+        if (this != &that)
+        {
+            this->value = that.value ? make_node<T>(*that.value) : nullptr;
+        }
         return *this;
     }
 
-    constexpr recursive_wrapper&
-    operator=(recursive_wrapper&& that) &
+    recursive_wrapper&
+    operator=(recursive_wrapper&& that) & noexcept
     {
         this->value = std::move(that.value);
         return *this;
     }
 
-    constexpr T& get() &
+    T& get() &
     {
         return *value;
     }
 
-    constexpr T const& get() const&
+    T const& get() const&
     {
         return *value;
     }
 
-    constexpr T&& get() &&
+    T&& get() &&
     {
         return std::move(*value);
     }
 
-    constexpr operator T& () &
+    operator T& () &
     {
         return *value;
     }
 
-    constexpr operator T const& () const&
+    operator T const& () const&
     {
         return *value;
     }
 
-    constexpr operator T&& () &&
+    operator T&& () &&
+    {
+        return std::move(*value);
+    }
+};
+
+// A recursive wrapper for trees that are rarely changed once built, such as
+// the ast. Copies share the T, which is only copied when changed through a
+// wrapper sharing it. References obtained from a non-const wrapper are thus
+// only valid until the wrapper is copied.
+template <typename T>
+class cow_wrapper
+{
+private:
+    std::shared_ptr<T> value;
+
+    T& unique()
+    {
+        if (value.use_count() > 1)
+        {
+            value = std::make_shared<T>(*value);
+        }
+        return *value;
+    }
+public:
+    cow_wrapper()
+        : value{std::make_shared<T>()} {}
+
+    cow_wrapper(T const& value)
+        : value{std::make_shared<T>(value)} {}
+
+    cow_wrapper(T&& value)
+        : value{std::make_shared<T>(std::move(value))} {}
+
+    cow_wrapper(cow_wrapper const& that) = default;
+
+    cow_wrapper(cow_wrapper&& that) noexcept = default;
+
+    cow_wrapper&
+    operator=(T const& value) &
+    {
+        this->value = std::make_shared<T>(value);
+        return *this;
+    }
+
+    cow_wrapper&
+    operator=(T&& value) &
+    {
+        this->value = std::make_shared<T>(std::move(value));
+        return *this;
+    }
+
+    cow_wrapper& operator=(cow_wrapper const& that) & = default;
+
+    cow_wrapper& operator=(cow_wrapper&& that) & noexcept = default;
+
+    // Whether the T is shared with other wrappers.
+    bool shared() const
+    {
+        return value.use_count() > 1;
+    }
+
+    T& get() &
+    {
+        return unique();
+    }
+
+    T const& get() const&
+    {
+        return *value;
+    }
+
+    T get() &&
+    {
+        return value.use_count() > 1 ? *value : std::move(*value);
+    }
+
+    operator T& () &
+    {
+        return unique();
+    }
+
+    operator T const& () const&
     {
         return *value;
     }
+
+    operator T () &&
+    {
+        return std::move(*this).get();
+    }
 };
 
 template <typename... Ts>
@@ -100,6 +312,10 @@ template <typename T, typename U>
 struct is_recursive<T, recursive_wrapper<U>>
     : std::integral_constant<bool, std::is_same_v<T, U>> {};
 
+template <typename T, typename U>
+struct is_recursive<T, cow_wrapper<U>>
+    : std::integral_constant<bool, std::is_same_v<T, U>> {};
+
 template <typename T, typename... Ts>
 struct is_recursive<T, recursive_variant<Ts...>>
     : std::integral_constant<bool, (is_recursive<T, Ts>::value || ...)> {};
@@ -130,11 +346,18 @@ decltype(auto) wrap(T&& x)
     }
 }
 
+// A std::variant whose alternatives may be recursive wrappers, visited as
+// the types they wrap. It adds no state of its own, so it is as large as the
+// std::variant, whose index is a single byte for the alternative counts used
+// here, and trivially copyable and destructible when all alternatives are.
 template <typename... Ts>
 struct recursive_variant
 {
     using storage_type = std::variant<Ts...>;
 
+    static_assert(sizeof...(Ts) <= std::numeric_limits<unsigned char>::max(),
+                  "the index of a recursive variant fits into a byte");
+
     storage_type storage;
 
     constexpr recursive_variant()
@@ -156,19 +379,10 @@ struct recursive_variant
     {
     }
 
-    constexpr recursive_variant& operator=(recursive_variant const& that) &
-    {
-        this->storage = that.storage;
-        return *this;
-    }
+    constexpr recursive_variant& operator=(recursive_variant const& that) = default;
 
-    constexpr recursive_variant& operator=(recursive_variant&& that) &
-        noexcept(((std::is_nothrow_move_constructible_v<Ts> &&
-                   std::is_nothrow_move_assignable_v<Ts>)   && ...))
-    {
-        this->storage = std::move(that.storage);
-        return *this;
-    }
+    constexpr recursive_variant& operator=(recursive_variant&& that)
+        noexcept(std::is_nothrow_move_assignable_v<storage_type>) = default;
 
     template <
         typename T,
@@ -187,8 +401,6 @@ struct recursive_variant
         this->storage = std::forward<T>(value);
         return *this;
     }
-
-    virtual ~recursive_variant() = default;
 };
 
 template <typename T, typename... Ts>
@@ -20,4 +20,25 @@ compile(compiler_scope const& scope, ast::reference const& ref)
     return it->second;
 }
 
+compiler_expect<ir::expression>
+translate(compiler_scope const& scope, ast::reference const& ref)
+{
+    auto local = scope.locals.find(ref.name);
+    if (local != scope.locals.end())
+    {
+        auto const& [id, type] = local->second;
+        return compiler_result<ir::expression>{ir::local{ref.name, type, id}, type};
+    }
+    auto result = compile(scope, ref);
+    if (is_success(result))
+    {
+        auto& [slot, type] = get_success(result);
+        return compiler_result<ir::expression>{ir::parameter{ref.name, type, slot}, type};
+    }
+    else
+    {
+        return std::move(get_failure(result));
+    }
+}
+
 }  // namespace ant
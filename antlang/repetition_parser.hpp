@@ -39,8 +39,8 @@ struct parser<repetition<T, End>>
     using attribute_type = attribute_of_t<repetition<T, End>>;
 
     parser_result<attribute_type>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         std::vector<rep_attr> values;
         end_attr end_value;
@@ -1,5 +1,7 @@
 #include "runtime.hpp"
 
+#include "closure.hpp"
+
 namespace ant
 {
 namespace runtime
@@ -21,6 +23,21 @@ value_variant execute(operation& op)
     return op.impl(arg0, arg1);
 }
 
+value_variant execute(slot_operation& op)
+{
+    return op.impl(*op.lhs, *op.rhs);
+}
+
+value_variant execute(slot_constant_operation& op)
+{
+    return op.impl(*op.lhs, op.rhs);
+}
+
+value_variant execute(constant_slot_operation& op)
+{
+    return op.impl(op.lhs, *op.rhs);
+}
+
 value_variant execute(function& func)
 {
     return execute(func.value);
@@ -31,11 +48,16 @@ value_variant execute(evaluation& eval)
     auto* func = eval.blueprint;
     auto& params = func->parameters;
     auto& args = eval.arguments;
-    const auto backup = params;
+    auto identity = [](value_variant& x) -> value_variant& { return x; };
+    slot_backup backup(params, identity);
     auto exec_arg = [](auto& arg) { return execute(arg); };
     std::transform(args.begin(), args.end(), params.begin(), exec_arg);
-    auto result = execute(*func);
-    params = backup;
+    if (func->tier && !func->promoted && ++func->calls >= func->tier->threshold)
+    {
+        func->promoted = promote(*func->tier, *func);
+    }
+    auto result = func->promoted ? execute(*func->promoted) : execute(*func);
+    backup.restore(params, identity);
     return result;
 }
 
@@ -46,16 +68,34 @@ structure execute(construction& ctor)
 
 value_variant execute(condition& cond)
 {
-    for (auto& [check_expr, value_expr] : cond.branches)
+    for (size_t i = 0; i < cond.branches.size(); ++i)
     {
+        auto& [check_expr, value_expr] = cond.branches[i];
         if (get<bool>(execute(check_expr)))
         {
+            if (cond.hits)
+            {
+                ++cond.hits[i];
+            }
             return execute(value_expr);
         }
     }
+    if (cond.hits)
+    {
+        ++cond.hits[cond.branches.size()];
+    }
     return execute(cond.fallback);
 }
 
+value_variant execute(guard& expr)
+{
+    if (get<bool>(expr.check(*expr.slot, expr.constant)))
+    {
+        return execute(expr.value);
+    }
+    return execute(expr.fallback);
+}
+
 struct expression_executor
 {
     value_variant operator()(value_variant& value) const
@@ -73,6 +113,21 @@ struct expression_executor
         return execute(op);
     }
 
+    value_variant operator()(slot_operation& op) const
+    {
+        return execute(op);
+    }
+
+    value_variant operator()(slot_constant_operation& op) const
+    {
+        return execute(op);
+    }
+
+    value_variant operator()(constant_slot_operation& op) const
+    {
+        return execute(op);
+    }
+
     value_variant operator()(evaluation& eval) const
     {
         return execute(eval);
@@ -88,6 +143,16 @@ struct expression_executor
         return execute(cond);
     }
 
+    value_variant operator()(guard& expr) const
+    {
+        return execute(expr);
+    }
+
+    value_variant operator()(probe& expr) const
+    {
+        return execute(expr);
+    }
+
     value_variant operator()(std::unique_ptr<scope>& expr) const
     {
         return execute(*expr);
@@ -106,17 +171,11 @@ void execute(binding& expr)
 
 value_variant execute(scope& expr)
 {
-    std::vector<value_variant> backup;
-    backup.reserve(expr.bindings.size());
-    std::transform(expr.bindings.cbegin(), expr.bindings.cend(),
-                   std::back_inserter(backup),
-                   [](auto const& e) { return e.result; });
+    auto result_of = [](binding& e) -> value_variant& { return e.result; };
+    slot_backup backup(expr.bindings, result_of);
     std::for_each(expr.bindings.begin(), expr.bindings.end(), [](auto& e) { execute(e); });
-    const auto value = execute(expr.value);
-    for (size_t i = 0; i < backup.size(); ++i)
-    {
-        expr.bindings.at(i).result = std::move(backup.at(i));
-    }
+    auto value = execute(expr.value);
+    backup.restore(expr.bindings, result_of);
     return value;
 }
 
@@ -4,6 +4,7 @@
 #include "recursive_variant.hpp"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
 #include <stdexcept>
@@ -37,6 +38,14 @@ struct value_variant : public value_variant_base
 
 struct function;
 
+struct closure;
+
+struct tiering;
+
+struct profiler;
+
+struct function_profile;
+
 struct construction
 {
     function* prototype;
@@ -48,12 +57,10 @@ struct construction
 };
 
 using binary_operator =
-    std::function<
-        value_variant(
-            value_variant const&,
-            value_variant const&
-        )
-    >;
+    value_variant (*)(
+        value_variant const&,
+        value_variant const&
+    );
 
 struct operation
 {
@@ -63,19 +70,45 @@ struct operation
     operation(function* blueprint, binary_operator impl);
 };
 
+template <template <typename> class Operator, typename Type>
+value_variant apply_binary_operator(value_variant const& lhs, value_variant const& rhs)
+{
+    return Operator<Type>{}(get<Type>(lhs), get<Type>(rhs));
+}
+
 template <template <typename> class Operator, typename Type>
 operation make_binary_operator(function* blueprint)
 {
-    using variant = runtime::value_variant;
-    auto impl = [](variant const& lhs, variant const& rhs) -> variant
-    {
-        return Operator<Type>{}(get<Type>(lhs), get<Type>(rhs));
-    };
-    return operation(blueprint, impl);
+    return operation(blueprint, &apply_binary_operator<Operator, Type>);
 }
 
+// Superinstructions, an operation fused with its slot and constant operands.
+
+struct slot_operation
+{
+    binary_operator impl;
+    value_variant* lhs;
+    value_variant* rhs;
+};
+
+struct slot_constant_operation
+{
+    binary_operator impl;
+    value_variant* lhs;
+    value_variant rhs;
+};
+
+struct constant_slot_operation
+{
+    binary_operator impl;
+    value_variant lhs;
+    value_variant* rhs;
+};
+
 struct evaluation;
 struct condition;
+struct guard;
+struct probe;
 struct scope;
 
 using expression_base =
@@ -84,8 +117,13 @@ using expression_base =
         value_variant*,
         construction,
         operation,
+        slot_operation,
+        slot_constant_operation,
+        constant_slot_operation,
         recursive_wrapper<evaluation>,
         recursive_wrapper<condition>,
+        recursive_wrapper<guard>,
+        recursive_wrapper<probe>,
         std::unique_ptr<scope>
     >;
 
@@ -98,6 +136,12 @@ struct function
 {
     std::vector<value_variant> parameters;
     expression value;
+    // Set when tiering is enabled, see closure.hpp. Calls through the tree
+    // walker are counted and the function is promoted to a closure once
+    // it gets hot.
+    tiering* tier = nullptr;
+    closure const* promoted = nullptr;
+    size_t calls = 0;
 };
 
 struct evaluation
@@ -122,6 +166,27 @@ struct condition
 {
     std::vector<branch> branches;
     expression fallback;
+    // Hit count of every branch followed by the fallback, when profiling.
+    uint64_t* hits = nullptr;
+};
+
+// Superinstruction for a condition branch comparing a slot with a constant.
+struct guard
+{
+    binary_operator check;
+    value_variant* slot;
+    value_variant constant;
+    expression value;
+    expression fallback;
+};
+
+// Records the calls and time of a function body, only present in the
+// runtime tree when profiling, see profiler.hpp.
+struct probe
+{
+    profiler* owner;
+    function_profile* profile;
+    expression value;
 };
 
 struct binding
@@ -165,6 +230,50 @@ using std::less;
 using std::greater_equal;
 using std::less_equal;
 
+// Saves the values of a sequence of slots, on the stack when few enough,
+// so that calls and scopes with few slots do not allocate.
+class slot_backup
+{
+public:
+    static constexpr size_t inline_size = 8;
+
+    template <typename Slots, typename Projection>
+    slot_backup(Slots& slots, Projection project)
+        : size{slots.size()}
+    {
+        if (size > inline_size)
+        {
+            heap_values.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                heap_values.push_back(project(slots[i]));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                inline_values[i] = project(slots[i]);
+            }
+        }
+    }
+
+    template <typename Slots, typename Projection>
+    void restore(Slots& slots, Projection project)
+    {
+        value_variant* values = size > inline_size ? heap_values.data() : inline_values.data();
+        for (size_t i = 0; i < size; ++i)
+        {
+            project(slots[i]) = std::move(values[i]);
+        }
+    }
+
+private:
+    size_t size;
+    std::array<value_variant, inline_size> inline_values;
+    std::vector<value_variant> heap_values;
+};
+
 struct program
 {
     std::vector<std::unique_ptr<function>> functions;
@@ -177,12 +286,22 @@ value_variant execute(evaluation& eval);
 
 value_variant execute(operation& op);
 
+value_variant execute(slot_operation& op);
+
+value_variant execute(slot_constant_operation& op);
+
+value_variant execute(constant_slot_operation& op);
+
 structure execute(construction& ctor);
 
 value_variant execute(expression& expr);
 
 value_variant execute(condition& expr);
 
+value_variant execute(guard& expr);
+
+value_variant execute(probe& expr);
+
 void execute(binding& expr);
 
 value_variant execute(scope& expr);
@@ -5,27 +5,26 @@
 namespace ant
 {
 
-compiler_expect<std::unique_ptr<runtime::scope>>
-compile(compiler_environment const& env,
-        compiler_scope const& parent_scope,
-        ast::scope const& expr)
+compiler_expect<ir::scope>
+translate(compiler_environment const& env,
+          compiler_scope const& parent_scope,
+          ast::scope const& expr)
 {
     compiler_scope scope = parent_scope;
-    auto compiled_let = std::make_unique<runtime::scope>();
-    compiled_let->bindings.reserve(expr.bindings.size());
+    ir::scope compiled_let;
+    compiled_let.bindings.reserve(expr.bindings.size());
 
     for (size_t i = 0; i < expr.bindings.size(); ++i)
     {
         auto const& binding = expr.bindings.at(i);
-        auto it = scope.parameters.find(binding.name);
-        if (it != scope.parameters.end())
+        if (scope.parameters.count(binding.name) || scope.locals.count(binding.name))
         {
             std::stringstream message;
             message << "Redefinition of parameter " << binding.name;
             return compiler_failure{message.str(), binding.context};
         }
 
-        auto binding_value_result = compile(env, scope, binding.value);
+        auto binding_value_result = translate(env, scope, binding.value);
 
         if (is_failure(binding_value_result))
         {
@@ -34,17 +33,12 @@ compile(compiler_environment const& env,
 
         auto& [binding_value, binding_value_type] = get_success(binding_value_result);
 
-        auto binding_result_prototype = runtime::execute(binding_value);
-        runtime::binding compiled_binding = {std::move(binding_result_prototype), std::move(binding_value)};
-        compiled_let->bindings.push_back(std::move(compiled_binding));
-        compiler_result<runtime::value_variant*> result = {
-            &compiled_let->bindings.back().result,
-            std::move(binding_value_type)
-        };
-        scope.parameters.insert(it, std::make_pair(binding.name, std::move(result)));
+        const size_t id = (*scope.local_count)++;
+        compiled_let.bindings.push_back({binding.name, id, std::move(binding_value)});
+        scope.locals[binding.name] = {id, std::move(binding_value_type)};
     }
 
-    auto value_result = compile(env, scope, expr.value);
+    auto value_result = translate(env, scope, expr.value);
 
     if (is_failure(value_result))
     {
@@ -53,12 +47,21 @@ compile(compiler_environment const& env,
 
     auto& [value_expr, value_type] = get_success(value_result);
 
-    compiled_let->value = std::move(value_expr);
+    compiled_let.type = value_type;
+    compiled_let.value = std::move(value_expr);
 
-    return compiler_result<std::unique_ptr<runtime::scope>>{
+    return compiler_result<ir::scope>{
         std::move(compiled_let),
         value_type
     };
 }
 
+compiler_expect<std::unique_ptr<runtime::scope>>
+compile(compiler_environment const& env,
+        compiler_scope const& scope,
+        ast::scope const& expr)
+{
+    return lower(translate(env, scope, expr));
+}
+
 }  // namespace ant
@@ -19,8 +19,8 @@ struct parser<sequence<Ts...>>
     result_type
     recursive_sub_parse(
             attribute_type& values,
-            const std::vector<token>::const_iterator pos,
-            const std::vector<token>::const_iterator end,
+            const token_iterator pos,
+            const token_iterator end,
             const std::index_sequence<>,
             const std::index_sequence<>) const
     {
@@ -31,8 +31,8 @@ struct parser<sequence<Ts...>>
     result_type
     recursive_sub_parse(
             attribute_type& values,
-            const std::vector<token>::const_iterator pos,
-            const std::vector<token>::const_iterator end,
+            const token_iterator pos,
+            const token_iterator end,
             const std::index_sequence<RuleIdx, RuleInds...>,
             const std::index_sequence<>) const
     {
@@ -64,8 +64,8 @@ struct parser<sequence<Ts...>>
     result_type
     recursive_sub_parse(
             attribute_type& values,
-            const std::vector<token>::const_iterator pos,
-            const std::vector<token>::const_iterator end,
+            const token_iterator pos,
+            const token_iterator end,
             std::index_sequence<RuleIdx, RuleInds...> rule_inds,
             std::index_sequence<AttrIdx, AttrInds...> attr_inds) const
     {
@@ -109,8 +109,8 @@ struct parser<sequence<Ts...>>
     }
 
     result_type
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         parser_success<attribute_type> success;
         return recursive_sub_parse(
@@ -1,5 +1,8 @@
 #include "compiler.hpp"
 
+#include "lazy_functions.hpp"
+#include "passes.hpp"
+
 namespace ant
 {
 
@@ -22,6 +25,7 @@ make_constructor_meta(ast::structure const& structure)
     std::transform(structure.fields.begin(), structure.fields.end(),
                    std::back_inserter(meta.parameter_types),
                    [](auto const& field) { return field.type; });
+    meta.inlining.reason = "structure constructor";
     return meta;
 }
 
@@ -32,10 +36,25 @@ struct statement_compiler
 
     compiler_status operator()(ast::function const& function)
     {
-        auto result = compile(env, function);
+        if (function.deferred_body && !env.lazy)
+        {
+            auto parsed = parse_body(function);
+            if (is_failure(parsed))
+            {
+                return std::move(get_failure(parsed));
+            }
+            return (*this)(get_success(parsed));
+        }
+        auto result = function.deferred_body ? declare(env, function) : compile(env, function);
         if (is_success(result))
         {
             auto [meta, blueprint] = std::move(get_success(result));
+            meta.definition = ++env.definitions;
+            if (function.deferred_body)
+            {
+                meta.inlining.reason = "compiled on first call";
+                env.lazy->defer(*blueprint, function, meta);
+            }
             env.functions[function.name].push_back({std::move(meta), blueprint.get()});
             program.functions.push_back(std::move(blueprint));
             return compiler_success{function.name};
@@ -54,6 +73,7 @@ struct statement_compiler
             std::unique_ptr<runtime::structure> prototype = std::move(get_success(result));
             std::unique_ptr<runtime::function> constructor = make_constructor(*prototype);
             function_meta meta = make_constructor_meta(structure);
+            meta.definition = ++env.definitions;
             env.prototypes[structure.name] = std::make_unique<runtime::value_variant>(*prototype);
             env.functions[structure.name].push_back({std::move(meta), constructor.get()});
             program.functions.push_back(std::move(constructor));
@@ -67,16 +87,38 @@ struct statement_compiler
 
     compiler_status operator()(ast::evaluation const& eval)
     {
-        compiler_expect<runtime::evaluation> result = compile(env, {}, eval);
-        if (is_success(result))
+        compiler_scope scope;
+        compiler_expect<ir::call> result = translate(env, scope, eval);
+        if (is_failure(result))
         {
-            program.evaluations.push_back(std::move(get_success(result).value));
-            return compiler_success{};
+            return std::move(get_failure(result));
+        }
+
+        ir::function translated;
+        translated.name = "evaluation";
+        translated.return_type = get_success(result).type;
+        translated.locals = *scope.local_count;
+        translated.body = std::move(get_success(result).value);
+
+        if (env.passes)
+        {
+            run_passes(*env.passes, env, translated);
+        }
+
+        lowering_scope lowering;
+        if (holds<ir::call>(translated.body))
+        {
+            program.evaluations.push_back(lower(lowering, get<ir::call>(translated.body)));
         }
         else
         {
-            return std::move(get_failure(result));
+            // optimized into something other than a call, evaluate it through a nullary function
+            auto wrapper = std::make_unique<runtime::function>();
+            wrapper->value = lower(lowering, translated.body);
+            program.evaluations.emplace_back(wrapper.get());
+            program.functions.push_back(std::move(wrapper));
         }
+        return compiler_success{};
     }
 };
 
@@ -0,0 +1,94 @@
+#include "compiler.hpp"
+
+#include <optional>
+
+namespace ant
+{
+
+namespace
+{
+
+struct operand_fuser
+{
+    runtime::binary_operator impl;
+
+    std::optional<runtime::expression>
+    operator()(runtime::value_variant* lhs, runtime::value_variant* rhs) const
+    {
+        return runtime::slot_operation{impl, lhs, rhs};
+    }
+
+    std::optional<runtime::expression>
+    operator()(runtime::value_variant* lhs, runtime::value_variant& rhs) const
+    {
+        return runtime::slot_constant_operation{impl, lhs, std::move(rhs)};
+    }
+
+    std::optional<runtime::expression>
+    operator()(runtime::value_variant& lhs, runtime::value_variant* rhs) const
+    {
+        return runtime::constant_slot_operation{impl, std::move(lhs), rhs};
+    }
+
+    template <typename Lhs, typename Rhs>
+    std::optional<runtime::expression>
+    operator()(Lhs&, Rhs&) const
+    {
+        return std::nullopt;
+    }
+};
+
+} // namespace
+
+runtime::expression
+fuse(runtime::evaluation&& eval)
+{
+    // The blueprint of a recursive call is still being compiled, and its
+    // value is thus not an operation.
+    auto const& value = eval.blueprint->value;
+    if (!holds<runtime::operation>(value) || eval.arguments.size() != 2)
+    {
+        return std::move(eval);
+    }
+    operand_fuser fuser{get<runtime::operation>(value).impl};
+    auto& lhs = eval.arguments.at(0).storage;
+    auto& rhs = eval.arguments.at(1).storage;
+    auto fused = std::visit(fuser, lhs, rhs);
+    if (fused)
+    {
+        return std::move(*fused);
+    }
+    return std::move(eval);
+}
+
+runtime::expression
+fuse(runtime::condition&& cond)
+{
+    if (cond.branches.empty())
+    {
+        return std::move(cond.fallback);
+    }
+    // guards do not count branch hits
+    if (cond.hits)
+    {
+        return std::move(cond);
+    }
+    auto& [check, value] = cond.branches.front();
+    if (!holds<runtime::slot_constant_operation>(check))
+    {
+        return std::move(cond);
+    }
+    auto& comparison = get<runtime::slot_constant_operation>(check);
+    runtime::guard result{
+        comparison.impl,
+        comparison.lhs,
+        std::move(comparison.rhs),
+        std::move(value),
+        {}
+    };
+    cond.branches.erase(cond.branches.begin());
+    result.fallback = fuse(std::move(cond));
+    return result;
+}
+
+} // namespace ant
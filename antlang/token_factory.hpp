@@ -3,8 +3,11 @@
 #include "fundamental_types.hpp"
 #include "token_builder.hpp"
 
+#include <array>
+#include <cassert>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ant
@@ -24,6 +27,57 @@ public:
     std::string pattern() const;
 };
 
+namespace detail
+{
+
+std::string
+make_alternation_pattern(std::vector<std::string> const& sub_patterns);
+
+template <class Token>
+token_variant build_token(std::string_view data)
+{
+    if constexpr (token_has_value_v<Token>)
+    {
+        return Token{std::string(data)};
+    }
+    else
+    {
+        return Token{};
+    }
+}
+
+} // namespace detail
+
+// Builds tokens through a table of functions known at compile time, without
+// virtual calls or copies of the data. Unlike token_factory, the data is not
+// checked against the pattern of the token, which the tokenizer matched.
+template <class... Tokens>
+class token_dispatch final
+{
+private:
+    using build_function = token_variant (*)(std::string_view);
+
+    std::array<build_function, sizeof...(Tokens)> builders = {
+        &detail::build_token<Tokens>...
+    };
+public:
+    constexpr size_t size() const
+    {
+        return sizeof...(Tokens);
+    }
+
+    token_variant create(size_t index, std::string_view data) const
+    {
+        assert(index < size());
+        return builders[index](data);
+    }
+
+    std::string pattern() const
+    {
+        return detail::make_alternation_pattern({Tokens::pattern...});
+    }
+};
+
 template <class... Tokens>
 token_factory
 make_token_factory()
@@ -41,6 +95,11 @@ struct token_factory_builder
     {
         return make_token_factory<Tokens...>();
     }
+
+    static constexpr token_dispatch<Tokens...> make_dispatch()
+    {
+        return {};
+    }
 };
 
 template <class... Tokens>
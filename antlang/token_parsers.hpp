@@ -14,8 +14,8 @@ template <class Token>
 struct parser<non_attributed_token_rule<Token>>
 {
     parser_result<none>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         if (pos == end)
         {
@@ -23,11 +23,11 @@ struct parser<non_attributed_token_rule<Token>>
             message << "Unexpected end of input while parsing token";
             throw unexpected_end_of_input_error(message.str());
         }
-        if (!holds<Token>(pos->variant))
+        if (!holds<Token>(*pos))
         {
             std::stringstream message;
             message << "Expected token " << quote(Token::name)
-                    << ", got " << quote(token_name(pos->variant));
+                    << ", got " << quote(token_name(pos->kind()));
             return parser_failure{message.str(), pos};
         }
         return parser_success<none>{{}, pos + 1};
@@ -38,8 +38,8 @@ template <class Token, typename Attribute>
 struct parser<attributed_token_rule<Token, Attribute>>
 {
     parser_result<Attribute>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         if (pos == end)
         {
@@ -47,14 +47,14 @@ struct parser<attributed_token_rule<Token, Attribute>>
             message << "Unexpected end of input while parsing token";
             throw unexpected_end_of_input_error(message.str());
         }
-        if (!holds<Token>(pos->variant))
+        if (!holds<Token>(*pos))
         {
             std::stringstream message;
             message << "Expected token " << quote(Token::name)
-                    << ", got " << quote(token_name(pos->variant));
+                    << ", got " << quote(token_name(pos->kind()));
             return parser_failure{message.str(), pos};
         }
-        return parser_success<Attribute>{get<Token>(pos->variant).value, pos + 1};
+        return parser_success<Attribute>{Attribute(pos->text()), pos + 1};
     }
 };
 
@@ -62,8 +62,8 @@ template <class Token>
 struct parser<attributed_token_rule<Token, none>>
 {
     parser_result<none>
-    parse(std::vector<token>::const_iterator pos,
-          std::vector<token>::const_iterator end) const
+    parse(token_iterator pos,
+          token_iterator end) const
     {
         if (pos == end)
         {
@@ -71,12 +71,12 @@ struct parser<attributed_token_rule<Token, none>>
             message << "Unexpected end of input while parsing token";
             throw unexpected_end_of_input_error(message.str());
         }
-        if (!holds<Token>(pos->variant))
+        if (!holds<Token>(*pos))
         {
             std::stringstream message;
             message << "Expected token " << quote(Token::name)
-                    << ", got " << quote(token_name(pos->variant));
-            return parser_success<none>{message.str(), pos->context};
+                    << ", got " << quote(token_name(pos->kind()));
+            return parser_failure{message.str(), pos};
         }
         return parser_result<none>{none{}, pos + 1};
     }
@@ -0,0 +1,88 @@
+#include "token_reader.hpp"
+
+#include "tokenize.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+namespace ant
+{
+
+namespace
+{
+
+struct line_scan
+{
+    // Depth of the brackets after the line.
+    long depth;
+    // Whether the line has more than spaces and a comment.
+    bool has_tokens;
+};
+
+line_scan scan_line(std::string_view line, long depth)
+{
+    bool has_tokens = false;
+    for (const char c : line)
+    {
+        if (c == ';')
+        {
+            break;
+        }
+        if (c == '(' || c == '[')
+        {
+            depth += 1;
+        }
+        else if (c == ')' || c == ']')
+        {
+            depth -= 1;
+        }
+        has_tokens = has_tokens || c != ' ';
+    }
+    return {depth, has_tokens};
+}
+
+} // namespace
+
+token_reader::token_reader(std::istream& input, scan_isa isa)
+    : input{input}
+    , isa{isa}
+{
+}
+
+bool token_reader::next()
+{
+    std::string source;
+    size_t first_line = line_number + 1;
+    long depth = 0;
+    bool has_tokens = false;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        line_number += 1;
+        const auto scan = scan_line(line, depth);
+        if (!has_tokens && !scan.has_tokens)
+        {
+            // blank lines and comments between forms
+            first_line = line_number + 1;
+            continue;
+        }
+        has_tokens = true;
+        depth = scan.depth;
+        source += line;
+        source += '\n';
+        if (depth <= 0)
+        {
+            break;
+        }
+    }
+    if (!has_tokens)
+    {
+        tokens = token_stream();
+        return false;
+    }
+    tokens = tokenize(std::move(source), first_line, isa);
+    peak = std::max(peak, tokens.size());
+    return true;
+}
+
+} // namespace ant
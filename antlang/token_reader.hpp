@@ -0,0 +1,61 @@
+#pragma once
+
+#include "delimiter_scan.hpp"
+#include "token_stream.hpp"
+
+#include <istream>
+#include <string>
+#include <utility>
+
+namespace ant
+{
+
+// Reads a source from a stream one top-level form at a time, to parse
+// sources without holding all of their tokens. Lines are read until the
+// brackets outside of comments are balanced, and the tokens of these lines
+// followed by an end of input token make up the window. Parsing the window
+// as a program gives its statements, with contexts counting lines from the
+// start of the source. The next window replaces the tokens of the previous
+// one, so the tokens held at once are those of the largest statement,
+// unless several statements share a line.
+class token_reader
+{
+public:
+    explicit token_reader(std::istream& input, scan_isa isa = best_scan_isa());
+
+    // Reads the lines of the next forms into the window, returns false when
+    // the source has no more tokens.
+    bool next();
+
+    token_stream const& window() const
+    {
+        return tokens;
+    }
+
+    // Moves the window out, to keep its tokens after reading the next one.
+    token_stream take_window()
+    {
+        return std::move(tokens);
+    }
+
+    // Number of lines read so far.
+    size_t lines() const
+    {
+        return line_number;
+    }
+
+    // Largest number of tokens of a window.
+    size_t peak_tokens() const
+    {
+        return peak;
+    }
+
+private:
+    std::istream& input;
+    scan_isa isa;
+    token_stream tokens;
+    size_t line_number = 0;
+    size_t peak = 0;
+};
+
+} // namespace ant
@@ -0,0 +1,144 @@
+#include "token_stream.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace ant
+{
+
+line_table::line_table(std::string_view source)
+{
+    for (size_t i = 0; i + 1 < source.size(); ++i)
+    {
+        if (source[i] == '\n')
+        {
+            starts.push_back(static_cast<uint32_t>(i + 1));
+        }
+    }
+}
+
+line_table::line_table(size_t first_line)
+    : first{first_line}
+{
+}
+
+void line_table::add_line(uint32_t start)
+{
+    starts.push_back(start);
+}
+
+void line_table::append(line_table const& part)
+{
+    starts.insert(starts.end(), std::next(part.starts.begin()), part.starts.end());
+}
+
+size_t line_table::size() const
+{
+    return starts.size();
+}
+
+size_t line_table::first_line() const
+{
+    return first;
+}
+
+size_t line_table::last_line() const
+{
+    return first + starts.size() - 1;
+}
+
+uint32_t line_table::start(size_t line) const
+{
+    if (line < first)
+    {
+        throw std::out_of_range("line before the first line of the table");
+    }
+    return starts.at(line - first);
+}
+
+token_context line_table::context(uint32_t offset) const
+{
+    const auto next = std::upper_bound(starts.begin(), starts.end(), offset);
+    const auto line = static_cast<int>(std::distance(starts.begin(), next) + first - 1);
+    return {line, static_cast<int>(offset - *std::prev(next)) + 1};
+}
+
+token token_ref::to_token() const
+{
+    return {make_token(kind(), text()), context()};
+}
+
+token_stream::token_stream(std::string source)
+    : source_text{std::move(source)}
+    , lines{source_text}
+{
+}
+
+token_stream::token_stream(std::string source, line_table lines)
+    : source_text{std::move(source)}
+    , lines{std::move(lines)}
+{
+}
+
+token_stream::token_stream(std::initializer_list<token> tokens)
+{
+    reserve(tokens.size());
+    for (auto const& token : tokens)
+    {
+        push_back(token);
+    }
+}
+
+void token_stream::reserve(size_t count)
+{
+    kinds.reserve(count);
+    offsets.reserve(count);
+    lengths.reserve(count);
+}
+
+void token_stream::push_back(token_variant const& variant, uint32_t offset)
+{
+    push_back(kind_of(variant), offset, token_text(variant).size());
+}
+
+void token_stream::push_back(token const& token)
+{
+    if (!source_text.empty())
+    {
+        source_text += ' ';
+    }
+    push_back(token.variant, source_text.size());
+    source_text += token_text(token.variant);
+}
+
+void token_stream::append(token_stream const& part)
+{
+    kinds.insert(kinds.end(), part.kinds.begin(), part.kinds.end());
+    offsets.insert(offsets.end(), part.offsets.begin(), part.offsets.end());
+    lengths.insert(lengths.end(), part.lengths.begin(), part.lengths.end());
+    lines.append(part.lines);
+}
+
+token_ref token_stream::at(size_t index) const
+{
+    if (index >= size())
+    {
+        throw std::out_of_range("token index out of range");
+    }
+    return {*this, index};
+}
+
+std::string_view token_stream::line(size_t number) const
+{
+    const size_t begin = lines.start(number);
+    const size_t last = lines.last_line();
+    size_t end = number < last ? lines.start(number + 1) - 1 : source_text.size();
+    if (number == last && end > begin && source_text[end - 1] == '\n')
+    {
+        end -= 1;
+    }
+    return std::string_view(source_text).substr(begin, end - begin);
+}
+
+} // namespace ant
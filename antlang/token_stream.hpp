@@ -0,0 +1,377 @@
+#pragma once
+
+#include "tokens.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ant
+{
+
+// Byte offsets of the lines of a source, to compute the context of a token
+// from its offset. The source may be a part of a larger one starting at a
+// later line, the lines are then counted from that line.
+class line_table
+{
+public:
+    line_table() = default;
+
+    explicit line_table(std::string_view source);
+
+    explicit line_table(size_t first_line);
+
+    // Records the start of the next line.
+    void add_line(uint32_t start);
+
+    // Records the lines of a table of a later part of the same source,
+    // after its first line, whose start is recorded already.
+    void append(line_table const& part);
+
+    // Number of lines, a final newline does not start a line.
+    size_t size() const;
+
+    size_t first_line() const;
+
+    size_t last_line() const;
+
+    // Offset of the first byte of a line, counted from 1.
+    uint32_t start(size_t line) const;
+
+    token_context context(uint32_t offset) const;
+
+private:
+    std::vector<uint32_t> starts = {0};
+    size_t first = 1;
+};
+
+class token_stream;
+
+// A token of a stream, its kind and text are stored by the stream.
+class token_ref
+{
+public:
+    token_ref(token_stream const& stream, size_t index)
+        : stream{&stream}
+        , index{index}
+    {
+    }
+
+    token_kind kind() const;
+
+    std::string_view text() const;
+
+    token_context context() const;
+
+    token to_token() const;
+
+private:
+    token_stream const* stream;
+    size_t index;
+};
+
+template <class Token>
+bool holds(token_ref const& token)
+{
+    return token.kind() == token_kind_of_v<Token>;
+}
+
+// Tokens of a source, stored as arrays of their kinds, offsets and lengths
+// with a copy of the source, which takes 9 bytes per token instead of a
+// token. Lines and columns are computed from a line table when needed.
+class token_stream
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = token_ref;
+        using difference_type = std::ptrdiff_t;
+        using reference = token_ref;
+
+        struct pointer
+        {
+            token_ref value;
+
+            token_ref const* operator->() const
+            {
+                return &value;
+            }
+        };
+
+        const_iterator() = default;
+
+        const_iterator(token_stream const& stream, size_t index)
+            : stream{&stream}
+            , index{index}
+        {
+        }
+
+        token_ref operator*() const
+        {
+            return {*stream, index};
+        }
+
+        pointer operator->() const
+        {
+            return {**this};
+        }
+
+        token_ref operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        const_iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto result = *this;
+            ++index;
+            return result;
+        }
+
+        const_iterator& operator--()
+        {
+            --index;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            auto result = *this;
+            --index;
+            return result;
+        }
+
+        const_iterator& operator+=(difference_type n)
+        {
+            index += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n)
+        {
+            index -= n;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator+(difference_type n, const_iterator it)
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator-(const_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+        }
+
+        friend bool operator==(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index == rhs.index;
+        }
+
+        friend bool operator!=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index != rhs.index;
+        }
+
+        friend bool operator<(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index < rhs.index;
+        }
+
+        friend bool operator>(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index > rhs.index;
+        }
+
+        friend bool operator<=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index <= rhs.index;
+        }
+
+        friend bool operator>=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.index >= rhs.index;
+        }
+
+    private:
+        token_stream const* stream = nullptr;
+        size_t index = 0;
+    };
+
+    static constexpr size_t bytes_per_token =
+        sizeof(token_kind) + sizeof(uint32_t) + sizeof(uint32_t);
+
+    token_stream() = default;
+
+    explicit token_stream(std::string source);
+
+    // Stream of a source whose lines are found while lexing it.
+    token_stream(std::string source, line_table lines);
+
+    // Tokens separated by spaces on a single line, e.g. for tests.
+    token_stream(std::initializer_list<token> tokens);
+
+    void reserve(size_t count);
+
+    void push_back(token_kind kind, uint32_t offset, uint32_t length)
+    {
+        kinds.push_back(kind);
+        offsets.push_back(offset);
+        lengths.push_back(length);
+    }
+
+    void add_line(uint32_t start)
+    {
+        lines.add_line(start);
+    }
+
+    void push_back(token_variant const& variant, uint32_t offset);
+
+    // Appends the token and its text to the source, after a space.
+    void push_back(token const& token);
+
+    // Appends the tokens and lines of a stream lexed from a later part of
+    // the source of this one, with offsets into this source.
+    void append(token_stream const& part);
+
+    size_t size() const
+    {
+        return kinds.size();
+    }
+
+    bool empty() const
+    {
+        return kinds.empty();
+    }
+
+    token_kind kind(size_t index) const
+    {
+        return kinds[index];
+    }
+
+    std::string_view text(size_t index) const
+    {
+        return std::string_view(source_text).substr(offsets[index], lengths[index]);
+    }
+
+    uint32_t offset(size_t index) const
+    {
+        return offsets[index];
+    }
+
+    token_context context(size_t index) const
+    {
+        return lines.context(offsets[index]);
+    }
+
+    token_ref operator[](size_t index) const
+    {
+        return {*this, index};
+    }
+
+    token_ref at(size_t index) const;
+
+    token_ref back() const
+    {
+        return {*this, size() - 1};
+    }
+
+    const_iterator begin() const
+    {
+        return {*this, 0};
+    }
+
+    const_iterator end() const
+    {
+        return {*this, size()};
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    std::string const& source() const
+    {
+        return source_text;
+    }
+
+    size_t line_count() const
+    {
+        return lines.size();
+    }
+
+    size_t first_line() const
+    {
+        return lines.first_line();
+    }
+
+    // Text of a line, counted from 1, without its newline.
+    std::string_view line(size_t number) const;
+
+    uint32_t line_start(size_t number) const
+    {
+        return lines.start(number);
+    }
+
+private:
+    std::string source_text;
+    line_table lines;
+    std::vector<token_kind> kinds;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+};
+
+using token_iterator = token_stream::const_iterator;
+
+// The tokens from begin up to end of a stream.
+struct token_span
+{
+    token_stream const* tokens;
+    size_t begin;
+    size_t end;
+};
+
+inline token_kind token_ref::kind() const
+{
+    return stream->kind(index);
+}
+
+inline std::string_view token_ref::text() const
+{
+    return stream->text(index);
+}
+
+inline token_context token_ref::context() const
+{
+    return stream->context(index);
+}
+
+} // namespace ant
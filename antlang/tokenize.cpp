@@ -1,46 +1,280 @@
 #include "tokenize.hpp"
 
-#include "pre_processing.hpp"
-#include "tokenizer.hpp"
+#include "form_boundaries.hpp"
+#include "parallel.hpp"
 
 #include <algorithm>
+#include <optional>
+#include <vector>
 
 namespace ant
 {
 
-std::vector<token>
-tokenize(const std::string& source)
+namespace
+{
+
+// Average number of source bytes per token, to pre-size the stream.
+constexpr size_t expected_token_size = 3;
+
+// Smallest part of a source lexed by a thread of its own.
+constexpr size_t min_parallel_part = 1 << 16;
+
+bool is_digit(char c)
 {
-    std::stringstream stream(source);
-    std::vector<std::string> lines;
-    std::vector<ant::token> tokens;
-    std::string line;
-    int line_number = 0;
-    ant::tokenizer tokenizer;
+    return c >= '0' && c <= '9';
+}
+
+// Lexes the lines of a source into a stream, the bitmap of its delimiters
+// is used when given.
+class lexer
+{
+public:
+    lexer(std::string_view source, delimiter_bitmap const* delimiters, token_stream& tokens)
+        : source{source}
+        , delimiters{delimiters}
+        , tokens{tokens}
+    {
+    }
 
-    while (std::getline(stream, line))
+    // Lexes from the start of a line to the start of another or the end.
+    void run(size_t begin, size_t end)
     {
-        line_number += 1;
-        lines.push_back(line);
-        auto t = tokenizer.tokenize(ant::remove_comments(line));
-        std::transform(
-            std::move_iterator(t.begin()), std::move_iterator(t.end()),
-            std::back_inserter(tokens),
-            [line_number](ant::token&& token)
+        position = begin;
+        while (position < end)
+        {
+            next();
+        }
+    }
+
+private:
+    std::string_view source;
+    delimiter_bitmap const* delimiters;
+    token_stream& tokens;
+    size_t position = 0;
+
+    template <class Token>
+    void emit(size_t length)
+    {
+        tokens.push_back(token_kind_of_v<Token>, position, length);
+        position += length;
+    }
+
+    // Emits the token if the source continues with the word.
+    template <class Token>
+    bool emit_word(std::string_view word = Token::pattern)
+    {
+        if (source.substr(position, word.size()) != word)
+        {
+            return false;
+        }
+        emit<Token>(word.size());
+        return true;
+    }
+
+    // Length of a number at the position, the tokenizer tries floating point
+    // literals before integer literals.
+    std::pair<size_t, bool> scan_number() const
+    {
+        size_t end = position;
+        if (source[end] == '+' || source[end] == '-')
+        {
+            ++end;
+        }
+        const size_t digits = end;
+        while (end < source.size() && is_digit(source[end]))
+        {
+            ++end;
+        }
+        if (end == digits)
+        {
+            return {0, false};
+        }
+        if (end + 1 < source.size() && source[end] == '.' && is_digit(source[end + 1]))
+        {
+            end += 2;
+            while (end < source.size() && is_digit(source[end]))
             {
-                token.context.line = line_number;
-                return std::move(token);
-            });
+                ++end;
+            }
+            return {end - position, true};
+        }
+        return {end - position, false};
     }
 
-    tokens.push_back({
-        ant::end_of_input_token(), {
-            !tokens.empty() ? tokens.back().context.line : 1,
-            !tokens.empty() ? tokens.back().context.offset : 0
+    size_t next_non_space() const
+    {
+        if (delimiters)
+        {
+            return delimiters->next_non_space(position);
         }
-    });
+        size_t end = position + 1;
+        while (end < source.size() && source[end] == ' ')
+        {
+            ++end;
+        }
+        return end;
+    }
+
+    size_t identifier_end() const
+    {
+        if (delimiters)
+        {
+            return delimiters->next_delimiter(position + 1);
+        }
+        size_t end = position + 1;
+        while (end < source.size() && !is_delimiter(source[end]))
+        {
+            ++end;
+        }
+        return end;
+    }
+
+    void next()
+    {
+        switch (source[position])
+        {
+        case ' ':
+            position = next_non_space();
+            return;
+        case '\n':
+            ++position;
+            if (position < source.size())
+            {
+                tokens.add_line(position);
+            }
+            return;
+        case ';':
+            position = std::min(source.find('\n', position), source.size());
+            return;
+        case '(':
+            return emit<left_parenthesis_token>(1);
+        case ')':
+            return emit<right_parenthesis_token>(1);
+        case '[':
+            return emit<left_bracket_token>(1);
+        case ']':
+            return emit<right_bracket_token>(1);
+        }
+        // keywords and boolean literals are found even at the start of
+        // longer identifiers, numbers before them
+        switch (source[position])
+        {
+        case 'f':
+            if (emit_word<function_token>() || emit_word<boolean_literal_token>("false"))
+            {
+                return;
+            }
+            break;
+        case 's':
+            if (emit_word<structure_token>())
+            {
+                return;
+            }
+            break;
+        case 'w':
+            if (emit_word<condition_token>())
+            {
+                return;
+            }
+            break;
+        case 'l':
+            if (emit_word<scope_token>())
+            {
+                return;
+            }
+            break;
+        case 't':
+            if (emit_word<boolean_literal_token>("true"))
+            {
+                return;
+            }
+            break;
+        case '+':
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            if (const auto [number, floating] = scan_number(); number > 0)
+            {
+                return floating
+                    ? emit<floating_point_literal_token>(number)
+                    : emit<integer_literal_token>(number);
+            }
+            break;
+        }
+        emit<identifier_token>(identifier_end() - position);
+    }
+};
 
+void add_end_of_input(token_stream& tokens)
+{
+    tokens.push_back(token_kind_of_v<end_of_input_token>,
+                     !tokens.empty() ? tokens.offset(tokens.size() - 1) : 0,
+                     0);
+}
+
+} // namespace
+
+token_stream
+tokenize(const std::string& source, scan_isa isa)
+{
+    return tokenize(source, 1, isa);
+}
+
+token_stream
+tokenize(std::string source, size_t first_line, scan_isa isa)
+{
+    token_stream tokens(std::move(source), line_table{first_line});
+    const std::string_view text = tokens.source();
+    std::optional<delimiter_bitmap> delimiters;
+    if (isa != scan_isa::scalar)
+    {
+        delimiters.emplace(text, isa);
+    }
+    tokens.reserve(text.size() / expected_token_size + 1);
+    lexer(text, delimiters ? &*delimiters : nullptr, tokens).run(0, text.size());
+    add_end_of_input(tokens);
+    return tokens;
+}
+
+token_stream
+tokenize(const std::string& source, scan_isa isa, size_t threads)
+{
+    const size_t parts = std::min(threads, source.size() / min_parallel_part + 1);
+    if (parts <= 1)
+    {
+        return tokenize(source, isa);
+    }
+    token_stream tokens(source, line_table{});
+    const std::string_view text = tokens.source();
+    const std::vector<size_t> boundaries = split_at_forms(text, parts);
+    std::optional<delimiter_bitmap> delimiters;
+    if (isa != scan_isa::scalar)
+    {
+        delimiters.emplace(text, isa);
+    }
+    std::vector<token_stream> lexed(boundaries.size() - 1);
+    parallel_for(lexed.size(), threads, [&](size_t i) {
+        lexed[i].reserve((boundaries[i + 1] - boundaries[i]) / expected_token_size + 1);
+        lexer(text, delimiters ? &*delimiters : nullptr, lexed[i]).run(boundaries[i], boundaries[i + 1]);
+    });
+    size_t count = 1;
+    for (auto const& part : lexed)
+    {
+        count += part.size();
+    }
+    tokens.reserve(count);
+    for (auto const& part : lexed)
+    {
+        tokens.append(part);
+    }
+    add_end_of_input(tokens);
     return tokens;
 }
 
+token_stream
+tokenize(const std::string& source)
+{
+    return tokenize(source, best_scan_isa());
+}
+
 } // namespace ant
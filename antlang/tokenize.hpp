@@ -1,14 +1,34 @@
 #pragma once
 
-#include "tokens.hpp"
+#include "delimiter_scan.hpp"
+#include "token_stream.hpp"
 
+#include <cstddef>
 #include <string>
-#include <vector>
 
 namespace ant
 {
 
-std::vector<token>
+// Tokenizes a whole source in a single pass, skipping comments from ';' to
+// the end of the line. It finds the same tokens as the tokenizer does on
+// every line of the source. Unless the instruction set is scalar, the
+// delimiters of the source are found with it before lexing.
+token_stream
+tokenize(const std::string& source, scan_isa isa);
+
+// Tokenizes a part of a larger source starting at the first line, the
+// contexts of the tokens count lines from there.
+token_stream
+tokenize(std::string source, size_t first_line, scan_isa isa);
+
+// Tokenizes on up to the given number of threads, each lexing a part of
+// whole top-level forms of the source, see split_at_forms. Gives the same
+// tokens as tokenizing on a single thread, which small sources are.
+token_stream
+tokenize(const std::string& source, scan_isa isa, size_t threads);
+
+// Tokenizes with the best instruction set of the processor.
+token_stream
 tokenize(const std::string& source);
 
 } // namespace ant
@@ -3,6 +3,13 @@
 namespace ant
 {
 
+namespace
+{
+
+constexpr auto dispatch = token_factory_builder<token_variant>::make_dispatch();
+
+} // namespace
+
 tokenizer::tokenizer(token_factory&& factory)
     : pattern(factory.pattern())
     , factory(std::move(factory))
@@ -10,16 +17,19 @@ tokenizer::tokenizer(token_factory&& factory)
 }
 
 tokenizer::tokenizer()
-    : tokenizer(token_factory_builder<token_variant>::make())
+    : pattern(dispatch.pattern())
 {
 }
 
-std::vector<token>
-tokenizer::tokenize(std::string const& source) const
+// Calls consume with the index of the sub pattern, the position and the data
+// of every token.
+template <typename Consumer>
+void
+tokenizer::for_each_token(std::string_view source, Consumer&& consume) const
 {
-    const auto matches_end = std::sregex_iterator();
-    std::vector<token> tokens;
-    for (auto matches = std::sregex_iterator(source.begin(), source.end(), pattern);
+    using match_iterator = std::regex_iterator<std::string_view::const_iterator>;
+    const auto matches_end = match_iterator();
+    for (auto matches = match_iterator(source.begin(), source.end(), pattern);
          matches != matches_end;
          ++matches)
     {
@@ -27,17 +37,45 @@ tokenizer::tokenize(std::string const& source) const
         {
             if (sub_match->length() == 0)
                 continue;
-            const int sub_match_index = std::distance(matches->begin() + 1, sub_match);
-            const int sub_match_position = matches->position(1 + sub_match_index);
-            token_variant variant = factory.create(sub_match_index, sub_match->str());
-            token_context context = {
-                -1,
-                static_cast<int>(sub_match_position) + 1
-            };
-            tokens.push_back({std::move(variant), std::move(context)});
+            const size_t sub_match_index = std::distance(matches->begin() + 1, sub_match);
+            const size_t sub_match_position = matches->position(1 + sub_match_index);
+            consume(sub_match_index,
+                    sub_match_position,
+                    source.substr(sub_match_position, sub_match->length()));
         }
     }
+}
+
+std::vector<token>
+tokenizer::tokenize(std::string const& source) const
+{
+    std::vector<token> tokens;
+    for_each_token(source, [this, &tokens](size_t index, size_t position, std::string_view data)
+    {
+        token_variant variant = factory
+            ? factory->create(index, std::string(data))
+            : dispatch.create(index, data);
+        token_context context = {
+            -1,
+            static_cast<int>(position) + 1
+        };
+        tokens.push_back({std::move(variant), std::move(context)});
+    });
     return tokens;
 }
 
+void
+tokenizer::tokenize(std::string_view line, uint32_t offset, token_stream& tokens) const
+{
+    for_each_token(line, [this, offset, &tokens](size_t index, size_t position, std::string_view data)
+    {
+        // the sub patterns of the default tokenizer are in the order of the
+        // token kinds
+        const token_kind kind = factory
+            ? kind_of(factory->create(index, std::string(data)))
+            : static_cast<token_kind>(index);
+        tokens.push_back(kind, offset + position, data.size());
+    });
+}
+
 } // namespace ant
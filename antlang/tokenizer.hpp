@@ -2,9 +2,13 @@
 
 #include "tokens.hpp"
 #include "token_factory.hpp"
+#include "token_stream.hpp"
 
+#include <cstdint>
+#include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ant
@@ -14,15 +18,24 @@ class tokenizer
 {
 public:
 
+    // Builds tokens with the given factory, which is slower than the
+    // compile time dispatch of the default tokenizer.
     explicit tokenizer(token_factory&& factory);
 
     tokenizer();
 
     std::vector<token> tokenize(std::string const& source) const;
 
+    // Appends the tokens of a line, found at the given offset of the source
+    // of the stream, without building them.
+    void tokenize(std::string_view line, uint32_t offset, token_stream& tokens) const;
+
 private:
+    template <typename Consumer>
+    void for_each_token(std::string_view source, Consumer&& consume) const;
+
     std::regex pattern;
-    token_factory factory;
+    std::optional<token_factory> factory;
 };
 
 } // namespace ant
@@ -1,5 +1,10 @@
 #include "tokens.hpp"
 
+#include "token_factory.hpp"
+
+#include <array>
+#include <utility>
+
 namespace ant
 {
 
@@ -15,6 +20,37 @@ struct token_name_visitor
     }
 };
 
+struct token_text_visitor
+{
+    template <typename TokenAlternative>
+    std::string_view operator()(TokenAlternative const& token)
+    {
+        if constexpr (token_has_value_v<TokenAlternative>)
+        {
+            return token.value;
+        }
+        else if constexpr (std::is_same_v<TokenAlternative, end_of_input_token>)
+        {
+            return {};
+        }
+        else
+        {
+            return TokenAlternative::name;
+        }
+    }
+};
+
+template <class... Tokens>
+struct token_table;
+
+template <class... Tokens>
+struct token_table<recursive_variant<Tokens...>>
+{
+    static constexpr std::array<char const*, sizeof...(Tokens)> names = {Tokens::name...};
+};
+
+using tokens = token_table<token_variant>;
+
 } // namespace
 
 std::string token_name(token_variant const& variant)
@@ -22,4 +58,25 @@ std::string token_name(token_variant const& variant)
     return visit(token_name_visitor(), variant);
 }
 
+std::string token_name(token_kind kind)
+{
+    return tokens::names.at(kind);
+}
+
+token_kind kind_of(token_variant const& variant)
+{
+    return static_cast<token_kind>(variant.storage.index());
+}
+
+std::string_view token_text(token_variant const& variant)
+{
+    return visit(token_text_visitor(), variant);
+}
+
+token_variant make_token(token_kind kind, std::string_view text)
+{
+    static constexpr auto dispatch = token_factory_builder<token_variant>::make_dispatch();
+    return dispatch.create(kind, text);
+}
+
 } // ant
@@ -2,7 +2,10 @@
 
 #include "recursive_variant.hpp"
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace ant
 {
@@ -118,6 +121,42 @@ struct token
     token_context context;
 };
 
+// Index of the alternative of a token in token_variant.
+using token_kind = uint8_t;
+
+namespace detail
+{
+
+template <class Token, class Variant>
+struct token_kind_of;
+
+template <class Token, class... Tokens>
+struct token_kind_of<Token, recursive_variant<Tokens...>>
+{
+    static_assert((std::is_same_v<Token, Tokens> || ...));
+
+    static constexpr token_kind value = [] {
+        token_kind index = 0;
+        ((std::is_same_v<Token, Tokens> ? false : (++index, true)) && ...);
+        return index;
+    }();
+};
+
+template <class Token, typename = void>
+struct has_value : std::false_type {};
+
+template <class Token>
+struct has_value<Token, std::void_t<decltype(Token::value)>> : std::true_type {};
+
+} // namespace detail
+
+// Whether tokens of the alternative carry their source text as value.
+template <class Token>
+constexpr bool token_has_value_v = detail::has_value<Token>::value;
+
+template <class Token>
+constexpr token_kind token_kind_of_v = detail::token_kind_of<Token, token_variant>::value;
+
 template <class TokenAlternative>
 std::string token_name()
 {
@@ -126,4 +165,15 @@ std::string token_name()
 
 std::string token_name(token_variant const& variant);
 
+std::string token_name(token_kind kind);
+
+token_kind kind_of(token_variant const& variant);
+
+// Source text of a token, its value or, for punctuation and keywords, its
+// name.
+std::string_view token_text(token_variant const& variant);
+
+// Token of the given kind with the given source text.
+token_variant make_token(token_kind kind, std::string_view text);
+
 } // namespace ant
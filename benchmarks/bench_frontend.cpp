@@ -0,0 +1,226 @@
+#include "benchmark.hpp"
+
+#include "compiler.hpp"
+#include "lazy_functions.hpp"
+#include "parallel_parser.hpp"
+#include "parser.hpp"
+#include "pre_processing.hpp"
+#include "program_generator.hpp"
+#include "token_reader.hpp"
+#include "tokenize.hpp"
+#include "tokenizer.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace ant;
+
+token_stream const& generated_tokens(size_t functions)
+{
+    static std::map<size_t, token_stream> cache;
+    auto it = cache.find(functions);
+    if (it == cache.end())
+    {
+        it = cache.emplace(functions, tokenize(bench::generated_program(functions))).first;
+    }
+    return it->second;
+}
+
+ast::program const& generated_ast(size_t functions)
+{
+    static std::map<size_t, ast::program> cache;
+    auto it = cache.find(functions);
+    if (it == cache.end())
+    {
+        auto const& tokens = generated_tokens(functions);
+        const auto parsed = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+        if (is_failure(parsed))
+        {
+            throw std::runtime_error("Generated program does not parse");
+        }
+        it = cache.emplace(functions, get_success(parsed).value).first;
+    }
+    return it->second;
+}
+
+std::string const& generated_source(size_t functions)
+{
+    static std::map<size_t, std::string> sources;
+    auto& source = sources[functions];
+    if (source.empty())
+    {
+        source = bench::generated_program(functions);
+    }
+    return source;
+}
+
+double tokenize_generated(size_t functions)
+{
+    auto const& source = generated_source(functions);
+    const auto tokens = tokenize(source);
+    return source.size();
+}
+
+double tokenize_generated(size_t functions, scan_isa isa)
+{
+    if (!is_supported(isa))
+    {
+        return 0;
+    }
+    auto const& source = generated_source(functions);
+    const auto tokens = tokenize(source, isa);
+    return source.size();
+}
+
+double tokenize_threaded(size_t functions, size_t threads)
+{
+    auto const& source = generated_source(functions);
+    const auto tokens = tokenize(source, best_scan_isa(), threads);
+    return source.size();
+}
+
+// The tokenizer on every line, as tokenize did before lexing whole sources.
+double tokenize_lines(size_t functions)
+{
+    auto const& source = generated_source(functions);
+    const tokenizer tokenizer;
+    std::stringstream stream(source);
+    std::string line;
+    size_t tokens = 0;
+    while (std::getline(stream, line))
+    {
+        tokens += tokenizer.tokenize(remove_comments(line)).size();
+    }
+    return tokens > 0 ? source.size() : 0;
+}
+
+double parse_generated(size_t functions)
+{
+    auto const& tokens = generated_tokens(functions);
+    const auto parser = make_parser<ast::program>();
+    const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+    return is_success(parsed) ? tokens.size() : 0;
+}
+
+double parse_threaded(size_t functions, size_t threads)
+{
+    auto const& tokens = generated_tokens(functions);
+    const auto parsed = parse_program(tokens, threads);
+    return is_success(parsed) ? tokens.size() : 0;
+}
+
+// Lexes and parses a statement at a time, as the source is read.
+double parse_streamed(size_t functions)
+{
+    std::stringstream input(generated_source(functions));
+    token_reader reader(input);
+    const auto parser = make_parser<ast::program>();
+    size_t tokens = 0;
+    while (reader.next())
+    {
+        auto const& window = reader.window();
+        if (is_failure(parser.parse(window.cbegin(), window.cend())))
+        {
+            return 0;
+        }
+        tokens += window.size() - 1;
+    }
+    return tokens;
+}
+
+double compile_generated(size_t functions)
+{
+    auto const& program = generated_ast(functions);
+    auto [env, prog] = setup_compiler();
+    for (auto const& status : compile(prog, env, program))
+    {
+        if (is_failure(status))
+        {
+            return 0;
+        }
+    }
+    // every function is defined once per overload
+    return functions * generator_options{}.overloads;
+}
+
+// Parses and compiles, with the bodies of functions deferred to their first
+// call when lazy.
+double start_generated(size_t functions, bool lazy)
+{
+    auto const& tokens = generated_tokens(functions);
+    const auto parsed = lazy
+        ? parse_lazily(tokens)
+        : make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    if (is_failure(parsed))
+    {
+        return 0;
+    }
+    auto [env, prog] = setup_compiler();
+    lazy_functions deferred;
+    if (lazy)
+    {
+        env.lazy = &deferred;
+    }
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        if (is_failure(status))
+        {
+            return 0;
+        }
+    }
+    return functions * generator_options{}.overloads;
+}
+
+const bench::registration tokenize_small{
+    "tokenize/50", "MB/s", 1e6, [] { return tokenize_generated(50); }};
+const bench::registration tokenize_large{
+    "tokenize/500", "MB/s", 1e6, [] { return tokenize_generated(500); }};
+const bench::registration tokenize_scalar{
+    "tokenize/500/scalar", "MB/s", 1e6, [] { return tokenize_generated(500, scan_isa::scalar); }};
+const bench::registration tokenize_sse2{
+    "tokenize/500/sse2", "MB/s", 1e6, [] { return tokenize_generated(500, scan_isa::sse2); }};
+const bench::registration tokenize_avx2{
+    "tokenize/500/avx2", "MB/s", 1e6, [] { return tokenize_generated(500, scan_isa::avx2); }};
+const auto tokenize_scaling = [] {
+    std::vector<bench::registration> registrations;
+    for (size_t threads : {1, 2, 4, 8})
+    {
+        registrations.emplace_back(
+            "tokenize/5000/threads/" + std::to_string(threads), "MB/s", 1e6,
+            [threads] { return tokenize_threaded(5000, threads); });
+    }
+    return registrations;
+}();
+const bench::registration tokenize_regex{
+    "tokenize/500/regex", "MB/s", 1e6, [] { return tokenize_lines(500); }};
+const bench::registration parse_small{
+    "parse/50", "Mtokens/s", 1e6, [] { return parse_generated(50); }};
+const bench::registration parse_large{
+    "parse/500", "Mtokens/s", 1e6, [] { return parse_generated(500); }};
+const auto parse_scaling = [] {
+    std::vector<bench::registration> registrations;
+    for (size_t threads : {1, 2, 4, 8})
+    {
+        registrations.emplace_back(
+            "parse/500/threads/" + std::to_string(threads), "Mtokens/s", 1e6,
+            [threads] { return parse_threaded(500, threads); });
+    }
+    return registrations;
+}();
+const bench::registration parse_streamed_large{
+    "parse/500/streamed", "Mtokens/s", 1e6, [] { return parse_streamed(500); }};
+const bench::registration compile_small{
+    "compile/50", "kfunctions/s", 1e3, [] { return compile_generated(50); }};
+const bench::registration compile_large{
+    "compile/500", "kfunctions/s", 1e3, [] { return compile_generated(500); }};
+const bench::registration startup_eager{
+    "startup/50", "kfunctions/s", 1e3, [] { return start_generated(50, false); }};
+const bench::registration startup_lazy{
+    "startup/50/lazy", "kfunctions/s", 1e3, [] { return start_generated(50, true); }};
+
+}  // namespace
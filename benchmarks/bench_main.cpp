@@ -0,0 +1,62 @@
+#include "benchmark.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Runs the benchmarks whose name contains the filter, printing a line of
+// name, median nanoseconds per run, throughput and unit for each.
+int main(int argc, char** argv)
+{
+    std::string filter;
+    double min_time = 0.5;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg.rfind("--min-time=", 0) == 0)
+        {
+            min_time = std::stod(arg.substr(std::string("--min-time=").size()));
+        }
+        else if (arg == "--sizes")
+        {
+            for (auto const& [name, bytes] : ant::bench::object_sizes())
+            {
+                std::cout << std::left << std::setw(40) << name << std::right
+                          << std::setw(6) << bytes << " bytes\n";
+            }
+            return 0;
+        }
+        else if (arg == "--list")
+        {
+            for (auto const& bench : ant::bench::registry())
+            {
+                std::cout << bench.name << '\n';
+            }
+            return 0;
+        }
+        else if (arg.rfind("-", 0) == 0)
+        {
+            std::cerr << "usage: " << argv[0] << " [--list] [--sizes] [--min-time=seconds] [filter]\n";
+            return -1;
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+    const auto min_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(min_time));
+    for (auto const& bench : ant::bench::registry())
+    {
+        if (bench.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        const auto result = ant::bench::measure(bench, min_duration);
+        std::cout << std::left << std::setw(40) << bench.name << std::right
+                  << std::setw(16) << result.per_run.count() << " ns "
+                  << std::setw(14) << std::fixed << std::setprecision(2) << result.throughput
+                  << ' ' << bench.unit << '\n';
+    }
+    return 0;
+}
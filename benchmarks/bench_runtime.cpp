@@ -0,0 +1,108 @@
+#include "benchmark.hpp"
+
+#include "closure.hpp"
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "tokenize.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+using namespace ant;
+
+std::pair<compiler_environment, runtime::program>
+compile_kernel(std::string const& snippet, std::string const& evaluation)
+{
+    auto compiled = setup_compiler();
+    auto& [env, prog] = compiled;
+    const auto tokens = tokenize(bench::read_snippet(snippet) + "\n" + evaluation);
+    const auto parsed = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    if (is_failure(parsed))
+    {
+        throw std::runtime_error("Kernel " + snippet + " does not parse");
+    }
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        if (is_failure(status))
+        {
+            throw std::runtime_error("Kernel " + snippet + " does not compile");
+        }
+    }
+    return compiled;
+}
+
+// A snippet compiled with a scaled up evaluation appended, only the
+// appended evaluation is run. The program of the tree walker is compiled
+// apart, since tiering promotes the functions of the other one.
+struct kernel
+{
+    compiler_environment env;
+    runtime::program prog;
+    compiler_environment tree_env;
+    runtime::program tree;
+    runtime::closure_program closures;
+    runtime::tiering tier;
+
+    kernel(std::string const& snippet, std::string const& evaluation)
+    {
+        std::tie(env, prog) = compile_kernel(snippet, evaluation);
+        std::tie(tree_env, tree) = compile_kernel(snippet, evaluation);
+        runtime::enable_tiering(prog, tier);
+        closures.evaluations.push_back(runtime::compile_closure(closures, prog.evaluations.back()));
+    }
+};
+
+kernel& get_kernel(std::string const& snippet, std::string const& evaluation)
+{
+    static std::map<std::string, std::unique_ptr<kernel>> kernels;
+    auto& result = kernels[snippet + evaluation];
+    if (!result)
+    {
+        result = std::make_unique<kernel>(snippet, evaluation);
+    }
+    return *result;
+}
+
+// Runs the kernel with the tiered engine, which promotes its hot functions
+// on the first run.
+double run_tiered(std::string const& snippet, std::string const& evaluation)
+{
+    execute(get_kernel(snippet, evaluation).prog.evaluations.back());
+    return 1;
+}
+
+// Runs the kernel with the tree walker only, as cold code runs.
+double run_tree(std::string const& snippet, std::string const& evaluation)
+{
+    execute(get_kernel(snippet, evaluation).tree.evaluations.back());
+    return 1;
+}
+
+double run_closure(std::string const& snippet, std::string const& evaluation)
+{
+    execute(get_kernel(snippet, evaluation).closures.evaluations.back());
+    return 1;
+}
+
+#define ANT_KERNEL_BENCHMARKS(name, snippet, evaluation)                         \
+    const bench::registration name##_tiered{                                      \
+        "run/" #name "/tiered", "runs/s", 1,                                      \
+        [] { return run_tiered(snippet, evaluation); }};                          \
+    const bench::registration name##_tree{                                        \
+        "run/" #name "/tree", "runs/s", 1,                                        \
+        [] { return run_tree(snippet, evaluation); }};                            \
+    const bench::registration name##_closure{                                     \
+        "run/" #name "/closure", "runs/s", 1,                                     \
+        [] { return run_closure(snippet, evaluation); }};
+
+ANT_KERNEL_BENCHMARKS(fibonacci, "fibonacci.ant", "(fib (i32 27))")
+ANT_KERNEL_BENCHMARKS(fibonacci_iter, "fibonacci-iter.ant", "(fib (i32 40))")
+ANT_KERNEL_BENCHMARKS(count, "count.ant", "(count (i32 5000))")
+ANT_KERNEL_BENCHMARKS(sum, "sum.ant", "(sum (i32 5000))")
+ANT_KERNEL_BENCHMARKS(sum_iter, "sum-iter.ant", "(sum (i32 5000))")
+
+}  // namespace
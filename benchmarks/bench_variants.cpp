@@ -0,0 +1,64 @@
+#include "benchmark.hpp"
+
+#include "ast.hpp"
+#include "parser.hpp"
+#include "runtime.hpp"
+#include "tokenize.hpp"
+
+namespace
+{
+
+using namespace ant;
+
+constexpr size_t copied_objects = 4096;
+
+// Copies a vector of the objects, reporting the objects copied per second.
+template <typename T>
+double copy_objects(T const& prototype)
+{
+    static const std::vector<T> objects(copied_objects, prototype);
+    std::vector<T> copies = objects;
+    return copies.size();
+}
+
+// Copies a parsed program, whose conditions and scopes share
+// their subtrees between copies.
+ast::program const& parsed_program()
+{
+    static const ast::program program = [] {
+        const auto tokens = tokenize(bench::generated_program(50));
+        const auto parsed = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+        return get_success(parsed).value;
+    }();
+    return program;
+}
+
+double copy_program()
+{
+    ast::program copy = parsed_program();
+    return copy.statements.size();
+}
+
+const bench::object_size value_variant_size{"runtime::value_variant", sizeof(runtime::value_variant)};
+const bench::object_size expression_size{"runtime::expression", sizeof(runtime::expression)};
+const bench::object_size token_variant_size{"token_variant", sizeof(token_variant)};
+const bench::object_size token_size{"token", sizeof(token)};
+const bench::object_size stream_token_size{"token_stream per token", token_stream::bytes_per_token};
+const bench::object_size ast_literal_size{"ast::literal_variant", sizeof(ast::literal_variant)};
+const bench::object_size ast_expression_size{"ast::expression", sizeof(ast::expression)};
+const bench::object_size ast_statement_size{"ast::statement", sizeof(ast::statement)};
+
+const bench::registration copy_value{
+    "copy/value_variant", "Mcopies/s", 1e6,
+    [] { return copy_objects(runtime::value_variant{int32_t{42}}); }};
+const bench::registration copy_token{
+    "copy/token", "Mcopies/s", 1e6,
+    [] { return copy_objects(tokenize("(i32 42)").at(2).to_token()); }};
+const bench::registration copy_ast_literal{
+    "copy/ast::expression", "Mcopies/s", 1e6,
+    [] { return copy_objects(ast::expression{ast::literal_variant{ast::i32{42, {}}}}); }};
+
+const bench::registration copy_ast_program{
+    "copy/ast::program", "Kstatements/s", 1e3, copy_program};
+
+}  // namespace
@@ -0,0 +1,79 @@
+#include "benchmark.hpp"
+
+#include "program_generator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace ant
+{
+namespace bench
+{
+
+std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+registration::registration(std::string name, std::string unit, double unit_scale, std::function<double()> run)
+{
+    registry().push_back({std::move(name), std::move(unit), unit_scale, std::move(run)});
+}
+
+object_size::object_size(std::string name, size_t bytes)
+{
+    object_sizes().emplace_back(std::move(name), bytes);
+}
+
+std::vector<std::pair<std::string, size_t>>& object_sizes()
+{
+    static std::vector<std::pair<std::string, size_t>> sizes;
+    return sizes;
+}
+
+measurement measure(benchmark const& bench, std::chrono::nanoseconds min_time)
+{
+    using clock = std::chrono::steady_clock;
+    std::vector<std::pair<clock::duration, double>> runs;
+    const auto start = clock::now();
+    while (runs.size() < 3 || clock::now() - start < min_time)
+    {
+        const auto before = clock::now();
+        const double work = bench.run();
+        runs.emplace_back(clock::now() - before, work);
+    }
+    std::sort(runs.begin(), runs.end());
+    auto const& [elapsed, work] = runs.at(runs.size() / 2);
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    return {
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed),
+        seconds > 0 ? work / bench.unit_scale / seconds : 0,
+        runs.size()
+    };
+}
+
+std::string generated_program(size_t functions)
+{
+    generator_options options;
+    options.functions = functions;
+    options.evaluations = functions;
+    return generate_program(options);
+}
+
+std::string read_snippet(std::string const& name)
+{
+    const std::string path = std::string(ANTLANG_SNIPPETS_DIR) + "/" + name;
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("No such snippet " + path);
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+}  // namespace bench
+}  // namespace ant
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ant
+{
+namespace bench
+{
+
+// A measured operation. Every run returns the amount of work it did, in
+// the unit of the throughput, e.g. bytes for "MB/s".
+struct benchmark
+{
+    std::string name;
+    std::string unit;
+    double unit_scale;
+    std::function<double()> run;
+};
+
+std::vector<benchmark>& registry();
+
+// Registers a benchmark from the static initializer of a bench_*.cpp file.
+struct registration
+{
+    registration(std::string name, std::string unit, double unit_scale, std::function<double()> run);
+};
+
+// Size of a frequently used type, listed by --sizes.
+struct object_size
+{
+    object_size(std::string name, size_t bytes);
+};
+
+std::vector<std::pair<std::string, size_t>>& object_sizes();
+
+struct measurement
+{
+    std::chrono::nanoseconds per_run;
+    double throughput;
+    size_t runs;
+};
+
+// Runs the benchmark until min_time has elapsed, at least three times,
+// and reports the median run.
+measurement measure(benchmark const& bench, std::chrono::nanoseconds min_time);
+
+// Source of a program of the given number of functions, see
+// program_generator.hpp.
+std::string generated_program(size_t functions);
+
+// Contents of a file of the snippets directory.
+std::string read_snippet(std::string const& name);
+
+}  // namespace bench
+}  // namespace ant
@@ -10,7 +10,6 @@ fi
 packages=(
     cmake
     doctest-dev
-    libboost-all-dev
 )
 
 apt-get install -y ${packages[@]}
@@ -0,0 +1,64 @@
+#include "formatting.hpp"
+#include "program_generator.hpp"
+
+#include <iostream>
+#include <optional>
+#include <string>
+
+// Parses the value of a numeric option, e.g. --functions=1000.
+std::optional<uint64_t> numeric_option(std::string const& arg, std::string const& name)
+{
+    const std::string prefix = "--" + name + "=";
+    if (arg.rfind(prefix, 0) != 0)
+    {
+        return std::nullopt;
+    }
+    const std::string value = arg.substr(prefix.size());
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+    {
+        return std::nullopt;
+    }
+    return std::stoull(value);
+}
+
+int main(int argc, char** argv)
+{
+    ant::generator_options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (auto seed = numeric_option(arg, "seed"))
+        {
+            options.seed = *seed;
+        }
+        else if (auto functions = numeric_option(arg, "functions"))
+        {
+            options.functions = *functions;
+        }
+        else if (auto overloads = numeric_option(arg, "overloads"))
+        {
+            options.overloads = *overloads;
+        }
+        else if (auto depth = numeric_option(arg, "depth"))
+        {
+            options.depth = *depth;
+        }
+        else if (auto parameters = numeric_option(arg, "parameters"))
+        {
+            options.parameters = *parameters;
+        }
+        else if (auto evaluations = numeric_option(arg, "evaluations"))
+        {
+            options.evaluations = *evaluations;
+        }
+        else
+        {
+            std::cerr << "Invalid argument " << ant::quote(arg) << "\n\n\tusage: " << argv[0]
+                      << " [--seed=n] [--functions=n] [--overloads=1..11] [--depth=n]"
+                      << " [--parameters=n] [--evaluations=n]\n\n";
+            return -1;
+        }
+    }
+    std::cout << ant::generate_program(options);
+    return 0;
+}
@@ -1,17 +1,33 @@
+#include "bounded_queue.hpp"
+#include "c_emitter.hpp"
+#include "closure.hpp"
 #include "compiler.hpp"
 #include "formatting.hpp"
-#include "tokenizer.hpp"
+#include "histogram.hpp"
+#include "lazy_functions.hpp"
+#include "native_module.hpp"
+#include "parallel_parser.hpp"
+#include "passes.hpp"
+#include "profile.hpp"
+#include "tokenize.hpp"
 #include "parser.hpp"
-#include "pre_processing.hpp"
+#include "stats.hpp"
+#include "token_reader.hpp"
 #include "token_rules.hpp"
 
 #include <algorithm>
+#include <charconv>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <optional>
 #include <queue>
 #include <streambuf>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -28,23 +44,30 @@ read_file(std::ifstream& file)
         std::istreambuf_iterator<char>());
 }
 
+std::string
+read_stream(std::istream& input)
+{
+    return std::string(
+        std::istreambuf_iterator<char>(input),
+        std::istreambuf_iterator<char>());
+}
+
 struct failure_handler
 {
     std::string file_name;
-    std::vector<std::string> lines;
+    ant::token_stream const& tokens;
 
     failure_handler(std::string const& file_name,
-                    std::vector<std::string> const& lines)
+                    ant::token_stream const& tokens)
         : file_name{file_name}
-        , lines(lines)
+        , tokens(tokens)
     {
     }
 
 
     void show_context_info(ant::token_context context)
     {
-        const int line_index = context.line - 1;
-        const std::string line = lines.at(line_index);
+        const std::string_view line = tokens.line(context.line);
         const int line_length = line.size();
         const int pad_left = context.offset - 1;
         const int pad_right = line_length - pad_left - 1;
@@ -61,10 +84,10 @@ struct parser_failure_handler : failure_handler
 
     void handle(ant::parser_failure const& failure)
     {
-        std::cout << file_name << ":" << failure.position->context.line << ": " << failure.message;
+        std::cout << file_name << ":" << failure.position->context().line << ": " << failure.message;
         if (failure.children.empty())
         {
-            show_context_info(failure.position->context);
+            show_context_info(failure.position->context());
         }
         std::cout << '\n';
         for (auto const& sub_failure : failure.children)
@@ -101,7 +124,15 @@ template <typename T>
 std::string format(T const& terminal)
 {
     std::stringstream result;
-    result << terminal;
+    if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>)
+    {
+        // print the number, not the character
+        result << static_cast<int>(terminal);
+    }
+    else
+    {
+        result << terminal;
+    }
     return result.str();
 }
 
@@ -128,104 +159,707 @@ void print(ant::runtime::value_variant const& value)
     std::cout << format(value) << '\n';
 }
 
-struct token_formatter
+void print_tokens(ant::token_stream const& tokens)
+{
+    std::cout << "Parsed token stream:\n";
+    for (const auto token : tokens)
+    {
+        std::cout << ant::token_name(token.kind()) << ' ';
+    }
+    std::cout << '\n';
+}
+
+void print_histogram(ant::runtime::node_histogram const& histogram)
+{
+    std::vector<std::pair<std::string, size_t>> entries(histogram.begin(), histogram.end());
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](auto const& lhs, auto const& rhs) { return lhs.second > rhs.second; });
+    for (auto const& [name, count] : entries)
+    {
+        std::cout << std::setw(8) << count << ' ' << name << '\n';
+    }
+}
+
+// Records the branch hits of a run of the program with the tree walker.
+void train_branches(ant::ast::program const& statements,
+                    int optimization_level,
+                    ant::branch_profile& profile)
 {
-    template <typename T>
-    std::string operator()(T const&) const
+    auto [env, prog] = ant::setup_compiler();
+    ant::pass_manager passes = ant::make_pass_manager(optimization_level);
+    env.passes = &passes;
+    env.training = &profile;
+    for (auto const& status : compile(prog, env, statements))
+    {
+        if (is_failure(status))
+        {
+            return;
+        }
+    }
+    try
+    {
+        for (auto& eval : prog.evaluations)
+        {
+            execute(eval);
+        }
+    }
+    catch (ant::runtime::arithmetic_error const&)
     {
-        return ant::ast::name_of_v<T>;
+        // keep the hits recorded until the error
+    }
+}
+
+// Promotes the functions called at least the tier threshold in the recorded
+// run before running, instead of after as many calls through the tree walker.
+void promote_recorded(ant::compiler_environment const& env,
+                      ant::program_profile const& recorded,
+                      ant::runtime::tiering& tier)
+{
+    for (auto const& [name, overloads] : env.functions)
+    {
+        for (auto const& [meta, value] : overloads)
+        {
+            auto it = recorded.functions.find(ant::profile_key(name, meta.parameter_types));
+            if (value->tier && it != recorded.functions.end() && it->second.calls >= tier.threshold)
+            {
+                value->promoted = ant::runtime::promote(tier, *value);
+            }
+        }
+    }
+}
+
+struct options;
+
+// Reports and saves what the profiler recorded during the run, as requested
+// by the options.
+bool finish_profiling(options const& opts,
+                      ant::runtime::profiler const& profiler,
+                      ant::branch_profile const& branches);
+
+struct options
+{
+    std::string input_file_path;
+    bool histogram = false;
+    std::string engine = "tiered";
+    size_t tier_threshold = ant::runtime::default_tier_threshold;
+    int optimization_level = 0;
+    std::optional<std::string> dump_ir_after;
+    bool time_passes = false;
+    bool reorder_branches = false;
+    bool branch_report = false;
+    bool stats = false;
+    std::optional<std::string> profile_out;
+    std::optional<std::string> profile_in;
+    bool profile = false;
+    std::optional<std::string> flame_graph;
+    bool emit_c = false;
+    bool native = false;
+    std::string cache_directory = ant::default_native_cache_directory();
+    bool pipeline = false;
+    bool threaded = false;
+    size_t jobs = 1;
+    bool lazy = false;
+
+    bool profiling() const
+    {
+        return profile || flame_graph || profile_out;
     }
 };
 
-std::string format(ant::token const& token)
+bool finish_profiling(options const& opts,
+                      ant::runtime::profiler const& profiler,
+                      ant::branch_profile const& branches)
 {
-    return visit(token_formatter(), token.variant);
+    if (opts.profile)
+    {
+        ant::runtime::print_profile(std::cerr, profiler);
+    }
+    if (opts.flame_graph)
+    {
+        std::ofstream file(*opts.flame_graph);
+        ant::runtime::write_folded_stacks(file, profiler);
+        if (!file)
+        {
+            std::cerr << "Could not write flame graph stacks " << ant::quote(*opts.flame_graph) << '\n';
+            return false;
+        }
+    }
+    if (opts.profile_out)
+    {
+        std::ofstream file(*opts.profile_out);
+        ant::write_profile(file, ant::make_profile(profiler, branches));
+        if (!file)
+        {
+            std::cerr << "Could not write profile " << ant::quote(*opts.profile_out) << '\n';
+            return false;
+        }
+    }
+    return true;
 }
 
-void print_tokens(const std::vector<ant::token>& tokens)
+// The count written in decimal digits, none when it is not one or too large.
+std::optional<size_t> parse_count(std::string const& value)
 {
-    std::cout << "Parsed token stream:\n";
-    for (const auto& token : tokens)
+    size_t count = 0;
+    const auto [last, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (error != std::errc{} || last != value.data() + value.size())
     {
-        std::cout << format(token) << ' ';
+        return std::nullopt;
     }
-    std::cout << '\n';
+    return count;
 }
 
-int main(int argc, char** argv)
+std::optional<options> parse_options(int argc, char** argv)
 {
-    const int arg_count = argc - 1;
-    if (arg_count != 1)
+    options result;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cerr << "\n\tInvalid number of arguments, usage: " << argv[0] << " input-files\n\n";
-        return -1;
+        const std::string arg(argv[i]);
+        if (arg == "--histogram")
+        {
+            result.histogram = true;
+        }
+        else if (arg == "--emit-c")
+        {
+            result.emit_c = true;
+        }
+        else if (arg == "--native")
+        {
+            result.native = true;
+        }
+        else if (arg.rfind("--cache-dir=", 0) == 0)
+        {
+            result.cache_directory = arg.substr(std::string("--cache-dir=").size());
+        }
+        else if (arg.rfind("--engine=", 0) == 0)
+        {
+            result.engine = arg.substr(std::string("--engine=").size());
+            if (result.engine != "tiered" && result.engine != "tree" && result.engine != "closure")
+            {
+                std::cerr << "Unknown engine " << ant::quote(result.engine) << '\n';
+                return std::nullopt;
+            }
+        }
+        else if (arg.size() == 3 && arg.rfind("-O", 0) == 0 &&
+                 arg.back() >= '0' && arg.back() <= '0' + ant::max_optimization_level)
+        {
+            result.optimization_level = arg.back() - '0';
+        }
+        else if (arg.rfind("--dump-ir-after=", 0) == 0)
+        {
+            result.dump_ir_after = arg.substr(std::string("--dump-ir-after=").size());
+            if (!ant::find_pass(*result.dump_ir_after))
+            {
+                std::cerr << "Unknown pass " << ant::quote(*result.dump_ir_after) << '\n';
+                return std::nullopt;
+            }
+        }
+        else if (arg == "--time-passes")
+        {
+            result.time_passes = true;
+        }
+        else if (arg == "--reorder-branches")
+        {
+            result.reorder_branches = true;
+        }
+        else if (arg == "--branch-report")
+        {
+            result.branch_report = true;
+        }
+        else if (arg.rfind("--profile-out=", 0) == 0)
+        {
+            result.profile_out = arg.substr(std::string("--profile-out=").size());
+        }
+        else if (arg.rfind("--profile-in=", 0) == 0)
+        {
+            result.profile_in = arg.substr(std::string("--profile-in=").size());
+        }
+        else if (arg == "--pipeline")
+        {
+            result.pipeline = true;
+        }
+        else if (arg == "--pipeline=threaded")
+        {
+            result.pipeline = true;
+            result.threaded = true;
+        }
+        else if (arg == "--lazy")
+        {
+            result.lazy = true;
+        }
+        else if (arg == "--stats")
+        {
+            result.stats = true;
+        }
+        else if (arg == "--profile")
+        {
+            result.profile = true;
+        }
+        else if (arg.rfind("--flame-graph=", 0) == 0)
+        {
+            result.flame_graph = arg.substr(std::string("--flame-graph=").size());
+        }
+        else if (arg.rfind("--tier-threshold=", 0) == 0)
+        {
+            const std::string value = arg.substr(std::string("--tier-threshold=").size());
+            const auto threshold = parse_count(value);
+            if (!threshold)
+            {
+                std::cerr << "Invalid tier threshold " << ant::quote(value) << '\n';
+                return std::nullopt;
+            }
+            result.tier_threshold = *threshold;
+        }
+        else if (arg.rfind("--jobs=", 0) == 0)
+        {
+            const std::string value = arg.substr(std::string("--jobs=").size());
+            const auto jobs = parse_count(value);
+            if (!jobs || *jobs == 0)
+            {
+                std::cerr << "Invalid number of jobs " << ant::quote(value) << '\n';
+                return std::nullopt;
+            }
+            result.jobs = *jobs;
+        }
+        else if (arg.rfind("-", 0) == 0 && arg != "-")
+        {
+            std::cerr << "Unknown option " << ant::quote(arg) << '\n';
+            return std::nullopt;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
     }
-    const std::string input_file_path(argv[1]);
-    std::ifstream input_file(input_file_path);
-    if (!input_file)
+    if (positional.size() != 1)
     {
-        std::cerr << "No such file " << ant::quote(input_file_path) << '\n';
-        return -1;
+        return std::nullopt;
     }
-    const std::string source_code = read_file(input_file);
-    std::stringstream stream(source_code);
-    std::vector<std::string> lines;
-    std::vector<ant::token> tokens;
-    std::string line;
-    int line_number = 0;
-    ant::tokenizer tokenizer;
-
-    while (std::getline(stream, line))
-    {
-        line_number += 1;
-        lines.push_back(line);
-        auto t = tokenizer.tokenize(ant::remove_comments(line));
-        std::transform(
-            std::move_iterator(t.begin()), std::move_iterator(t.end()),
-            std::back_inserter(tokens),
-            [line_number](ant::token&& token)
+    if (result.dump_ir_after && ant::find_pass(*result.dump_ir_after)->level > result.optimization_level)
+    {
+        std::cerr << "Pass " << ant::quote(*result.dump_ir_after)
+                  << " does not run at -O" << result.optimization_level << '\n';
+        return std::nullopt;
+    }
+    if (result.profiling() && (result.emit_c || result.native))
+    {
+        std::cerr << "Profiles are recorded by the interpreter, not by native code\n";
+        return std::nullopt;
+    }
+    if (result.pipeline && (result.histogram || result.emit_c || result.native ||
+                            result.reorder_branches || result.profile_in))
+    {
+        std::cerr << "The pipeline runs every statement before reading the next one, "
+                  << "which rules out options needing the whole program\n";
+        return std::nullopt;
+    }
+    if (result.lazy && (result.pipeline || result.emit_c || result.native))
+    {
+        std::cerr << "Lazy functions are compiled by the interpreter from the tokens of the whole program\n";
+        return std::nullopt;
+    }
+    result.input_file_path = positional.front();
+    return result;
+}
+
+// A top-level form read by a pipelined run, its tokens are kept alive to
+// report the failures in it.
+struct parsed_form
+{
+    std::shared_ptr<ant::token_stream const> tokens;
+    ant::parser_result<ant::ast::program> result;
+};
+
+// Forms of windows read from a stream at a time of their own.
+constexpr size_t pipeline_depth = 16;
+
+// The reading and parsing stages of a pipelined run. When threaded, they
+// run on threads of their own connected by bounded queues, otherwise a
+// form is read and parsed when it is asked for.
+class pipeline_stages
+{
+public:
+    pipeline_stages(ant::token_reader& reader, bool threaded)
+        : reader{reader}
+    {
+        if (!threaded)
+        {
+            return;
+        }
+        threads.emplace_back([this] {
+            while (this->reader.next() &&
+                   windows.push(std::make_shared<ant::token_stream const>(this->reader.take_window())))
+            {
+            }
+            windows.close();
+        });
+        threads.emplace_back([this] {
+            while (auto tokens = windows.pop())
             {
-                token.context.line = line_number;
-                return std::move(token);
-            });
+                auto form = parse(std::move(*tokens));
+                const bool failed = is_failure(form.result);
+                if (!forms.push(std::move(form)) || failed)
+                {
+                    break;
+                }
+            }
+            windows.close();
+            forms.close();
+        });
+    }
+
+    ~pipeline_stages()
+    {
+        stop();
+    }
+
+    std::optional<parsed_form> next()
+    {
+        if (!threads.empty())
+        {
+            return forms.pop();
+        }
+        if (!reader.next())
+        {
+            return std::nullopt;
+        }
+        return parse(std::make_shared<ant::token_stream const>(reader.take_window()));
     }
 
-    tokens.push_back({
-        ant::end_of_input_token(), {
-            !tokens.empty() ? tokens.back().context.line : 1,
-            !tokens.empty() ? tokens.back().context.offset : 0
+    // Ends the stages, e.g. after a failure, and waits for their threads.
+    void stop()
+    {
+        windows.close();
+        forms.close();
+        for (auto& thread : threads)
+        {
+            thread.join();
         }
+        threads.clear();
+    }
+
+private:
+    static parsed_form parse(std::shared_ptr<ant::token_stream const> tokens)
+    {
+        const auto parser = ant::make_parser<ant::ast::program>();
+        auto result = parser.parse(tokens->cbegin(), tokens->cend());
+        return {std::move(tokens), std::move(result)};
+    }
+
+    ant::token_reader& reader;
+    ant::bounded_queue<std::shared_ptr<ant::token_stream const>> windows{pipeline_depth};
+    ant::bounded_queue<parsed_form> forms{pipeline_depth};
+    std::vector<std::thread> threads;
+};
+
+// Parses, compiles and runs a top-level form at a time, printing the results
+// of its evaluations before reading the next one. Neither the tokens nor the
+// ast of the whole program are held, and the first results are printed
+// before the end of the input, e.g. of a long running feed on stdin.
+int run_pipeline(options const& opts, std::istream& input)
+{
+    phase_stats stats(std::cerr, opts.stats);
+    stats.begin("pipeline");
+
+    auto [env, prog] = ant::setup_compiler();
+    ant::runtime::profiler profiler;
+    ant::branch_profile recorded_branches;
+    if (opts.profiling())
+    {
+        env.profiler = &profiler;
+    }
+    if (opts.profile_out)
+    {
+        env.training = &recorded_branches;
+    }
+    ant::pass_manager passes = ant::make_pass_manager(opts.optimization_level);
+    passes.dump_after = opts.dump_ir_after;
+    passes.dump = &std::cerr;
+    env.passes = &passes;
+    ant::runtime::tiering tier;
+    tier.threshold = opts.tier_threshold;
+    ant::runtime::closure_program closures;
+    size_t tiered = 0;
+
+    ant::token_reader reader(input);
+    pipeline_stages stages(reader, opts.threaded);
+    size_t statements = 0;
+    size_t evaluations = 0;
+    bool failed = false;
+    while (auto form = stages.next())
+    {
+        auto const& tokens = *form->tokens;
+        if (is_failure(form->result))
+        {
+            parser_failure_handler(opts.input_file_path, tokens).handle(get_failure(form->result));
+            print_tokens(tokens);
+            failed = true;
+            break;
+        }
+        for (auto const& statement : get_success(form->result).value.statements)
+        {
+            const ant::compiler_status status = compile(prog, env, statement);
+            if (is_failure(status))
+            {
+                compiler_failure_handler(opts.input_file_path, tokens).handle(get_failure(status));
+                failed = true;
+                break;
+            }
+            statements += 1;
+            if (opts.engine == "tiered")
+            {
+                ant::runtime::enable_tiering(prog, tier, tiered);
+                tiered = prog.functions.size();
+            }
+            for (auto& eval : prog.evaluations)
+            {
+                if (opts.engine == "closure")
+                {
+                    print(execute(ant::runtime::compile_closure(closures, eval)));
+                }
+                else
+                {
+                    print(execute(eval));
+                }
+                std::cout.flush();
+                evaluations += 1;
+            }
+            // evaluations only run once
+            prog.evaluations.clear();
+        }
+        if (failed)
+        {
+            break;
+        }
+    }
+    stages.stop();
+    stats.end({
+        {"lines", reader.lines()},
+        {"statements", statements},
+        {"evaluations", evaluations},
+        {"peak_window_tokens", reader.peak_tokens()}
     });
 
-    const auto parser = ant::make_parser<ant::ast::program>();
+    if (opts.time_passes)
+    {
+        ant::print_timings(std::cerr, passes);
+    }
+    if (failed)
+    {
+        return -1;
+    }
+    if (opts.profiling() && !finish_profiling(opts, profiler, recorded_branches))
+    {
+        return -1;
+    }
+    return 0;
+}
 
-    const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+int main(int argc, char** argv)
+{
+    const std::optional<options> opts = parse_options(argc, argv);
+    if (!opts)
+    {
+        std::cerr << "\n\tInvalid arguments, usage: " << argv[0] << " [--histogram] [--engine=tiered|tree|closure] [--tier-threshold=calls] [-O0|-O1|-O2] [--dump-ir-after=pass] [--time-passes] [--reorder-branches] [--branch-report] [--profile-out=file] [--profile-in=file] [--profile] [--flame-graph=file] [--stats] [--pipeline[=threaded]] [--jobs=N] [--lazy] [--emit-c] [--native] [--cache-dir=path] input-file|-\n\n";
+        return -1;
+    }
+    const std::string input_file_path = opts->input_file_path;
+    // the source is read from stdin for a path of -
+    const bool from_stdin = input_file_path == "-";
+    std::ifstream input_file;
+    if (!from_stdin)
+    {
+        input_file.open(input_file_path);
+        if (!input_file)
+        {
+            std::cerr << "No such file " << ant::quote(input_file_path) << '\n';
+            return -1;
+        }
+    }
+    if (opts->pipeline)
+    {
+        return run_pipeline(*opts, from_stdin ? std::cin : input_file);
+    }
+    phase_stats stats(std::cerr, opts->stats);
+    stats.begin("tokenize");
+    const std::string source_code = from_stdin ? read_stream(std::cin) : read_file(input_file);
+    const ant::token_stream tokens = ant::tokenize(source_code, ant::best_scan_isa(), opts->jobs);
+
+    stats.end({{"bytes", source_code.size()}, {"lines", tokens.line_count()}, {"tokens", tokens.size()}});
+
+    stats.begin("parse");
+    const auto parsed = opts->lazy ? ant::parse_lazily(tokens) : ant::parse_program(tokens, opts->jobs);
 
     if (is_failure(parsed))
     {
-        parser_failure_handler(input_file_path, lines).handle(get_failure(parsed));
+        parser_failure_handler(input_file_path, tokens).handle(get_failure(parsed));
         print_tokens(tokens);
         return -1;
     }
 
     ant::ast::program const& statements = ant::get_success(parsed).value;
+    stats.end({{"statements", statements.statements.size()}, {"ast_nodes", count_nodes(statements)}});
+
+    stats.begin("compile");
+
+    ant::program_profile recorded;
+    if (opts->profile_in)
+    {
+        std::ifstream profile_file(*opts->profile_in);
+        if (!profile_file)
+        {
+            std::cerr << "No such file " << ant::quote(*opts->profile_in) << '\n';
+            return -1;
+        }
+        auto profile = ant::read_profile(profile_file);
+        if (is_failure(profile))
+        {
+            std::cerr << *opts->profile_in << ": " << get_failure(profile) << '\n';
+            return -1;
+        }
+        recorded = std::move(get_success(profile));
+    }
+
+    ant::branch_profile branch_profile;
+    if (opts->reorder_branches)
+    {
+        train_branches(statements, opts->optimization_level, branch_profile);
+    }
+    else if (opts->profile_in)
+    {
+        branch_profile = recorded.branches;
+    }
 
     auto [env, prog] = ant::setup_compiler();
+    if (opts->reorder_branches || opts->profile_in)
+    {
+        env.profile = &branch_profile;
+    }
+    if (opts->profile_in)
+    {
+        env.recorded = &recorded;
+    }
+    ant::lazy_functions lazy;
+    if (opts->lazy)
+    {
+        env.lazy = &lazy;
+    }
+    ant::runtime::profiler profiler;
+    ant::branch_profile recorded_branches;
+    if (opts->profiling())
+    {
+        env.profiler = &profiler;
+    }
+    if (opts->profile_out)
+    {
+        env.training = &recorded_branches;
+    }
+    ant::pass_manager passes = ant::make_pass_manager(opts->optimization_level);
+    passes.dump_after = opts->dump_ir_after;
+    passes.dump = &std::cerr;
+    env.passes = &passes;
+    const size_t built_in_functions = prog.functions.size();
     const std::vector<ant::compiler_status> compile_info = compile(prog, env, statements);
+    stats.end({
+        {"functions", prog.functions.size() - built_in_functions},
+        {"evaluations", prog.evaluations.size()},
+        {"deferred_functions", lazy.deferred()},
+        {"compiled_lazily", lazy.compiled()}
+    });
+    if (opts->time_passes)
+    {
+        ant::print_timings(std::cerr, passes);
+    }
+    if (opts->branch_report)
+    {
+        ant::print_report(std::cerr, branch_profile);
+    }
     for (auto const& status : compile_info)
     {
         if (is_failure(status))
         {
-            compiler_failure_handler(input_file_path, lines).handle(get_failure(status));
+            compiler_failure_handler(input_file_path, tokens).handle(get_failure(status));
             return -1;
         }
     }
 
+    if (opts->histogram)
+    {
+        print_histogram(ant::runtime::make_histogram(prog));
+        return 0;
+    }
+
+    if (opts->emit_c || opts->native)
+    {
+        const auto c_source = ant::emit_c(env, statements);
+        if (opts->emit_c)
+        {
+            if (is_failure(c_source))
+            {
+                compiler_failure_handler(input_file_path, tokens).handle(get_failure(c_source));
+                return -1;
+            }
+            std::cout << get_success(c_source);
+            return 0;
+        }
+        if (is_failure(c_source))
+        {
+            std::cerr << "Falling back to the interpreter: " << get_failure(c_source).message << '\n';
+        }
+        else
+        {
+            auto module = ant::load_native_module(get_success(c_source), opts->cache_directory);
+            if (is_success(module))
+            {
+                auto const& native = get_success(module);
+                stats.begin("execute");
+                for (size_t i = 0; i < native.size(); ++i)
+                {
+                    print(native.execute(i));
+                }
+                stats.end({{"evaluations", native.size()}});
+                return 0;
+            }
+            std::cerr << "Falling back to the interpreter: " << get_failure(module) << '\n';
+        }
+    }
+
+    stats.begin("execute");
+    if (opts->engine == "closure")
+    {
+        const auto closures = ant::runtime::compile_closures(prog);
+        for (auto const& eval : closures.evaluations)
+        {
+            print(execute(eval));
+        }
+        stats.end({{"evaluations", closures.evaluations.size()}});
+        if (opts->profiling() && !finish_profiling(*opts, profiler, recorded_branches))
+        {
+            return -1;
+        }
+        return 0;
+    }
+
+    ant::runtime::tiering tier;
+    tier.threshold = opts->tier_threshold;
+    if (opts->engine == "tiered")
+    {
+        ant::runtime::enable_tiering(prog, tier);
+        promote_recorded(env, recorded, tier);
+    }
+
     for (auto& eval : prog.evaluations)
     {
         ant::runtime::value_variant result = execute(eval);
         print(result);
     }
+    stats.end({{"evaluations", prog.evaluations.size()}});
+
+    if (opts->profiling() && !finish_profiling(*opts, profiler, recorded_branches))
+    {
+        return -1;
+    }
 
     return 0;
 }
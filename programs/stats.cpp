@@ -0,0 +1,189 @@
+#include "stats.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace
+{
+
+// Allocations are only counted with --stats, so that other runs are not
+// slowed down by the accounting.
+std::atomic<bool> counting{false};
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> live_bytes{0};
+std::atomic<size_t> peak_bytes{0};
+
+// Every allocation is prefixed by its size, to account for it when freed,
+// which is 0 for blocks allocated before counting started.
+constexpr size_t header_size = alignof(std::max_align_t);
+
+struct node_counter
+{
+    size_t operator()(ant::ast::reference const&) const
+    {
+        return 1;
+    }
+
+    size_t operator()(ant::ast::literal_variant const&) const
+    {
+        return 1;
+    }
+
+    size_t operator()(ant::ast::evaluation const& eval) const
+    {
+        size_t count = 1;
+        for (auto const& arg : eval.arguments)
+        {
+            count += visit(*this, arg);
+        }
+        return count;
+    }
+
+    size_t operator()(ant::ast::condition const& cond) const
+    {
+        size_t count = 1 + visit(*this, cond.fallback.get());
+        for (auto const& branch : cond.branches)
+        {
+            count += visit(*this, branch.check) + visit(*this, branch.value);
+        }
+        return count;
+    }
+
+    size_t operator()(ant::ast::scope const& let) const
+    {
+        size_t count = 1 + visit(*this, let.value.get());
+        for (auto const& binding : let.bindings)
+        {
+            count += 1 + visit(*this, binding.value);
+        }
+        return count;
+    }
+
+    size_t operator()(ant::ast::function const& func) const
+    {
+        return 1 + func.parameters.size() + visit(*this, func.body);
+    }
+
+    size_t operator()(ant::ast::structure const& structure) const
+    {
+        return 1 + structure.fields.size();
+    }
+
+    template <typename T>
+    size_t operator()(ant::recursive_wrapper<T> const& x) const
+    {
+        return (*this)(x.get());
+    }
+};
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    auto* block = static_cast<char*>(std::malloc(header_size + size));
+    if (!block)
+    {
+        throw std::bad_alloc();
+    }
+    if (!counting.load(std::memory_order_relaxed))
+    {
+        *reinterpret_cast<size_t*>(block) = 0;
+        return block + header_size;
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+    return block + header_size;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+    auto* block = static_cast<char*>(pointer) - header_size;
+    if (const size_t size = *reinterpret_cast<size_t*>(block))
+    {
+        live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    std::free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void start_allocation_counting()
+{
+    counting.store(true, std::memory_order_relaxed);
+}
+
+allocation_counts current_allocations()
+{
+    return {allocations.load(), live_bytes.load(), peak_bytes.load()};
+}
+
+void reset_peak_allocation()
+{
+    peak_bytes.store(live_bytes.load());
+}
+
+size_t count_nodes(ant::ast::program const& program)
+{
+    size_t count = 0;
+    for (auto const& statement : program.statements)
+    {
+        count += visit(node_counter{}, statement);
+    }
+    return count;
+}
+
+phase_stats::phase_stats(std::ostream& out, bool enabled)
+    : out{out}
+    , enabled{enabled}
+{
+    if (enabled)
+    {
+        start_allocation_counting();
+    }
+}
+
+void phase_stats::begin(std::string phase)
+{
+    if (!enabled)
+    {
+        return;
+    }
+    this->phase = std::move(phase);
+    reset_peak_allocation();
+    allocations_at_start = current_allocations();
+    start = std::chrono::steady_clock::now();
+}
+
+void phase_stats::end(counters const& counts)
+{
+    if (!enabled)
+    {
+        return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto allocated = current_allocations();
+    out << "{\"phase\":\"" << phase << "\""
+        << ",\"wall_ms\":" << std::fixed << std::setprecision(3)
+        << std::chrono::duration<double, std::milli>(elapsed).count()
+        << ",\"allocations\":" << allocated.allocations - allocations_at_start.allocations
+        << ",\"peak_bytes\":" << allocated.peak_bytes;
+    for (auto const& [name, count] : counts)
+    {
+        out << ",\"" << name << "\":" << count;
+    }
+    out << "}\n";
+}
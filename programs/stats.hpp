@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ast.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Heap usage of the program, counted by the global operator new of antpile
+// once counting started.
+struct allocation_counts
+{
+    size_t allocations;
+    size_t live_bytes;
+    size_t peak_bytes;
+};
+
+allocation_counts current_allocations();
+
+// Counts the allocations from now on, started by phase_stats when enabled.
+void start_allocation_counting();
+
+// Restarts the peak at the bytes currently live.
+void reset_peak_allocation();
+
+size_t count_nodes(ant::ast::program const& program);
+
+// Prints the wall time, allocations and peak heap of every phase of
+// antpile as a JSON object per line, when enabled by --stats.
+class phase_stats
+{
+public:
+    using counters = std::vector<std::pair<std::string, size_t>>;
+
+    phase_stats(std::ostream& out, bool enabled);
+
+    void begin(std::string phase);
+
+    void end(counters const& counts = {});
+
+private:
+    std::ostream& out;
+    bool enabled;
+    std::string phase;
+    std::chrono::steady_clock::time_point start;
+    allocation_counts allocations_at_start;
+};
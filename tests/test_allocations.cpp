@@ -0,0 +1,146 @@
+#include <doctest/doctest.h>
+
+#include "closure.hpp"
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "tokenize.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every allocation of the test program, to check that the hot path
+// of the runtime does not allocate.
+namespace
+{
+
+std::atomic<size_t> allocation_count{0};
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+using namespace ant;
+
+namespace
+{
+
+template <typename F>
+size_t count_allocations(F&& f)
+{
+    const size_t before = allocation_count.load();
+    f();
+    return allocation_count.load() - before;
+}
+
+struct fixture
+{
+    compiler_environment env;
+    runtime::program prog;
+
+    fixture()
+    {
+        std::tie(env, prog) = setup_compiler();
+    }
+
+    void ensure_compiled(const std::string& source)
+    {
+        const auto tokens = tokenize(source);
+        const auto parser = make_parser<ast::program>();
+        const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+        REQUIRE(is_success(parsed));
+        for (auto const& status : compile(prog, env, get_success(parsed).value))
+        {
+            REQUIRE(is_success(status));
+        }
+    }
+};
+
+const std::string scalar_functions = R"(
+    (function fib i32 (i32 n)
+      (when [(= n (i32 0)) (i32 1)]
+            [(= n (i32 1)) (i32 1)]
+            (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+    (function sum-impl i32 (i32 accum i32 n)
+      (when [(= n (i32 0)) accum]
+            (sum-impl (+ accum n) (- n (i32 1)))))
+    (function sum i32 (i32 n)
+      (when [(= n (i32 0)) (i32 0)]
+        (let [tmp (sum (- n (i32 1)))]
+          (+ n tmp))))
+    (function fib-impl i64 (i64 n i64 a i64 b)
+      (let [c (+ a b)]
+        (when [(= n (i64 1)) b]
+              (fib-impl (- n (i64 1)) b c))))
+    (function many f64 (f64 a f64 b f64 c f64 d f64 e f64 f f64 g f64 h f64 i)
+      (when [(< a (f64 1.0)) (+ a i)]
+            (many (- a (f64 1.0)) b c d e f g h i)))
+    (fib (i32 15))
+    (sum-impl (i32 0) (i32 300))
+    (sum (i32 300))
+    (fib-impl (i64 60) (i64 1) (i64 1))
+)";
+
+}  // namespace
+
+TEST_CASE_FIXTURE(fixture, "executing scalar functions does not allocate after warm-up")
+{
+    ensure_compiled(scalar_functions);
+
+    SUBCASE("tree")
+    {
+        for (auto& eval : prog.evaluations)
+        {
+            execute(eval);
+            CHECK(count_allocations([&eval] { execute(eval); }) == 0);
+        }
+    }
+    SUBCASE("tiered")
+    {
+        runtime::tiering tier;
+        tier.threshold = 10;
+        runtime::enable_tiering(prog, tier);
+        for (auto& eval : prog.evaluations)
+        {
+            execute(eval);
+            CHECK(count_allocations([&eval] { execute(eval); }) == 0);
+        }
+    }
+    SUBCASE("closure")
+    {
+        const auto closures = runtime::compile_closures(prog);
+        for (auto const& eval : closures.evaluations)
+        {
+            execute(eval);
+            CHECK(count_allocations([&eval] { execute(eval); }) == 0);
+        }
+    }
+}
+
+TEST_CASE_FIXTURE(fixture, "calls with more slots than the inline backup run")
+{
+    ensure_compiled(scalar_functions + R"(
+        (many (f64 3.0) (f64 0.0) (f64 0.0) (f64 0.0) (f64 0.0) (f64 0.0) (f64 0.0) (f64 0.0) (f64 2.0))
+    )");
+    auto& eval = prog.evaluations.back();
+    CHECK(get<flt64_t>(execute(eval)) == doctest::Approx(2.0));
+    CHECK(get<flt64_t>(execute(eval)) == doctest::Approx(2.0));
+}
@@ -17,7 +17,7 @@ TEST_CASE("can parse alternative expression")
 
     SUBCASE("when expression is left parenthesis")
     {
-        const std::vector<token> tokens = {{left_parenthesis_token{}}};
+        const token_stream tokens = {{left_parenthesis_token{}}};
         const auto result = parser.parse(tokens.cbegin(), tokens.cend());
         REQUIRE(is_success(result));
         const auto [value, pos] = get_success(result);
@@ -27,7 +27,7 @@ TEST_CASE("can parse alternative expression")
 
     SUBCASE("when expression is identifier")
     {
-        const std::vector<token> tokens = {{identifier_token{"name"}}};
+        const token_stream tokens = {{identifier_token{"name"}}};
         const auto result = parser.parse(tokens.cbegin(), tokens.cend());
         REQUIRE(is_success(result));
         const auto [value, pos] = get_success(result);
@@ -47,7 +47,7 @@ TEST_CASE("alternative parser with prefix free alternatives returns failure "
                 identifier_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {right_parenthesis_token{}}
     };
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
@@ -72,7 +72,7 @@ TEST_CASE("alternative parser with shared-prefix alternatives returns failure "
                 >
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {right_parenthesis_token{}}
     };
@@ -98,7 +98,7 @@ TEST_CASE("alternative parser with shared-prefix alternatives returns failure "
             >
         >;
     const auto parser = make_parser<rule>();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {integer_literal_token{}},
         {identifier_token{}}
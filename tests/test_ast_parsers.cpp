@@ -9,7 +9,7 @@ using namespace ant;
 
 TEST_CASE("can parse parameter")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {identifier_token{"type"}},
         {identifier_token{"name"}}
@@ -25,7 +25,7 @@ TEST_CASE("can parse parameter")
 
 TEST_CASE("can parse function")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_parenthesis_token{}},
             {function_token{}},
@@ -58,7 +58,7 @@ TEST_CASE("can parse function")
 
 TEST_CASE("can parse structure")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_parenthesis_token{}},
         {structure_token{}},
@@ -80,7 +80,7 @@ TEST_CASE("can parse structure")
 
 TEST_CASE("can parse branch")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_bracket_token{}},
         {identifier_token{"boolean-condition"}},
@@ -94,7 +94,7 @@ TEST_CASE("can parse branch")
 
 TEST_CASE("can parse condition")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_parenthesis_token{}},
         {condition_token{}},
@@ -129,7 +129,7 @@ TEST_CASE("can parse condition")
 
 TEST_CASE("can parse identifier expression")
 {
-    const std::vector<token> tokens = { {identifier_token{"name"}} };
+    const token_stream tokens = { {identifier_token{"name"}} };
     const auto parser = make_parser<ast::expression>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -141,7 +141,7 @@ TEST_CASE("can parse identifier expression")
 
 TEST_CASE("can parse simple evaluation")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"func"}},
         {identifier_token{"arg1"}},
@@ -163,7 +163,7 @@ TEST_CASE("can parse simple evaluation")
 
 TEST_CASE("can parse evaluation expression")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"func"}},
         {identifier_token{"arg1"}},
@@ -187,7 +187,7 @@ TEST_CASE("can parse evaluation expression")
 
 TEST_CASE("can parse complex evaluation")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"outer-func"}},
         {left_parenthesis_token{}},
@@ -226,7 +226,7 @@ TEST_CASE("can parse complex evaluation")
 
 TEST_CASE("can parse boolean true literal")
 {
-    const std::vector<token> tokens = { {boolean_literal_token{"true"}} };
+    const token_stream tokens = { {boolean_literal_token{"true"}} };
     const auto parser = make_parser<ast::boolean>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -237,7 +237,7 @@ TEST_CASE("can parse boolean true literal")
 
 TEST_CASE("can parse boolean false literal")
 {
-    const std::vector<token> tokens = { {boolean_literal_token{"false"}} };
+    const token_stream tokens = { {boolean_literal_token{"false"}} };
     const auto parser = make_parser<ast::boolean>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -248,7 +248,7 @@ TEST_CASE("can parse boolean false literal")
 
 TEST_CASE("can parse 32 bit integer literal")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"i32"}},
         {integer_literal_token{"1337"}},
@@ -264,7 +264,7 @@ TEST_CASE("can parse 32 bit integer literal")
 
 TEST_CASE("parsing floating point literal as integer raises error")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"i32"}},
         {floating_point_literal_token{"13.37"}},
@@ -276,7 +276,7 @@ TEST_CASE("parsing floating point literal as integer raises error")
 
 TEST_CASE("parsing narrowing integer conversion raises error")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"u8"}},
         {integer_literal_token{"256"}},
@@ -286,9 +286,74 @@ TEST_CASE("parsing narrowing integer conversion raises error")
     CHECK(is_failure(parser.parse(tokens.cbegin(), tokens.cend())));
 }
 
+TEST_CASE("integer literals are range checked exactly")
+{
+    CHECK(convert_literal<int8_t>("-128") == int8_t{-128});
+    CHECK(convert_literal<int8_t>("127") == int8_t{127});
+    CHECK(!convert_literal<int8_t>("128"));
+    CHECK(convert_literal<uint8_t>("255") == uint8_t{255});
+    CHECK(!convert_literal<uint8_t>("-1"));
+    CHECK(convert_literal<uint64_t>("+18446744073709551615") == UINT64_MAX);
+    CHECK(!convert_literal<uint64_t>("18446744073709551616"));
+    CHECK(convert_literal<int64_t>("-9223372036854775808") == INT64_MIN);
+    CHECK(!convert_literal<int32_t>("13.37"));
+}
+
+TEST_CASE("floating point and boolean literals are converted")
+{
+    CHECK(convert_literal<double>("-13.5") == -13.5);
+    CHECK(convert_literal<float>("0.1") == 0.1f);
+    CHECK(!convert_literal<float>(std::string(40, '9') + ".0"));
+    CHECK(convert_literal<bool>("true") == true);
+    CHECK(convert_literal<bool>("false") == false);
+    CHECK(!convert_literal<bool>("1"));
+}
+
+TEST_CASE("literals not fitting their type are reported")
+{
+    const token_stream tokens = {
+        {left_parenthesis_token{}},
+        {identifier_token{"i8"}},
+        {integer_literal_token{"-129"}},
+        {right_parenthesis_token{}}
+    };
+    const auto parser = make_parser<ast::i8>();
+    const auto result = parser.parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_failure(result));
+    const parser_failure* failure = &get_failure(result);
+    while (!failure->children.empty())
+    {
+        failure = &failure->children.back();
+    }
+    CHECK(failure->message == "Literal '-129' does not fit into target type 'i8'");
+}
+
+TEST_CASE("floating point literals too small to represent round to zero")
+{
+    const std::string tiny = "0." + std::string(50, '0') + "1";
+    CHECK(convert_literal<float>(tiny) == 0.0f);
+    CHECK(convert_literal<double>("0." + std::string(400, '0') + "1") == 0.0);
+    CHECK(convert_literal<double>("-1e-400") == 0.0);
+    CHECK(convert_literal<float>("1e-40") > 0.0f);
+    CHECK(!convert_literal<float>("1e40"));
+    CHECK(!convert_literal<double>("0.1e400"));
+    CHECK(!convert_literal<int>("+-5"));
+    CHECK(!convert_literal<double>("+-5.0"));
+
+    const token_stream tokens = {
+        {left_parenthesis_token{}},
+        {identifier_token{"f32"}},
+        {floating_point_literal_token{tiny}},
+        {right_parenthesis_token{}}
+    };
+    const auto result = make_parser<ast::f32>().parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_success(result));
+    CHECK(get_success(result).value.value == 0.0f);
+}
+
 TEST_CASE("mismatching identifier token value and literal type raises error")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"i32"}},
         {integer_literal_token{"123"}},
@@ -300,7 +365,7 @@ TEST_CASE("mismatching identifier token value and literal type raises error")
 
 TEST_CASE("can parse 32 bit floating point literal")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"f32"}},
         {floating_point_literal_token{"13.37"}},
@@ -316,7 +381,7 @@ TEST_CASE("can parse 32 bit floating point literal")
 
 TEST_CASE("can parse literal variant with integer alternative")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"i32"}},
         {integer_literal_token{"1337"}},
@@ -334,7 +399,7 @@ TEST_CASE("can parse literal variant with integer alternative")
 
 TEST_CASE("can parse identifier expression")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {identifier_token{"name"}},
     };
     const auto parser = make_parser<ast::expression>();
@@ -349,7 +414,7 @@ TEST_CASE("can parse identifier expression")
 
 TEST_CASE("can parse literal expression")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"i32"}},
         {integer_literal_token{"1337"}},
@@ -369,7 +434,7 @@ TEST_CASE("can parse literal expression")
 
 TEST_CASE("can parse evaluation expression")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
             {identifier_token{"my-function"}},
 
@@ -402,7 +467,7 @@ TEST_CASE("can parse evaluation expression")
 
 TEST_CASE("can parse nested evaluation expression")
 {
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
             {identifier_token{"my-function"}},
 
@@ -438,7 +503,7 @@ TEST_CASE("can parse nested evaluation expression")
 
 TEST_CASE("can parse let expression")
 {
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_parenthesis_token{}},
         {scope_token{}},
@@ -475,7 +540,7 @@ TEST_CASE("can parse let expression")
 TEST_CASE("parser returns failure with position to first failing token with offset exceeding LCP")
 {
     const auto parser = make_parser<ast::statement>();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {structure_token{}},
         {integer_literal_token{}}
@@ -0,0 +1,54 @@
+#include <doctest/doctest.h>
+
+#include "bounded_queue.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace ant;
+
+TEST_CASE("bounded queues pop their values in order until closed")
+{
+    bounded_queue<int> queue(4);
+    CHECK(queue.push(1));
+    CHECK(queue.push(2));
+    queue.close();
+    CHECK(!queue.push(3));
+    CHECK(queue.pop() == 1);
+    CHECK(queue.pop() == 2);
+    CHECK(!queue.pop());
+}
+
+TEST_CASE("bounded queues hand values between threads")
+{
+    bounded_queue<int> queue(2);
+    std::thread producer([&queue] {
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.push(i);
+        }
+        queue.close();
+    });
+    std::vector<int> values;
+    while (auto value = queue.pop())
+    {
+        values.push_back(*value);
+    }
+    producer.join();
+    REQUIRE(values.size() == 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(values.at(i) == i);
+    }
+}
+
+TEST_CASE("closing a bounded queue releases a waiting producer")
+{
+    bounded_queue<int> queue(1);
+    CHECK(queue.push(0));
+    bool pushed = true;
+    std::thread producer([&] { pushed = queue.push(1); });
+    queue.close();
+    producer.join();
+    CHECK(!pushed);
+}
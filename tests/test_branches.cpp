@@ -0,0 +1,139 @@
+#include <doctest/doctest.h>
+
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "passes.hpp"
+#include "tokenize.hpp"
+
+#include <sstream>
+
+using namespace ant;
+
+namespace
+{
+
+struct fixture
+{
+    compiler_environment env;
+    runtime::program prog;
+    pass_manager passes = make_pass_manager(1);
+    std::stringstream dump;
+
+    fixture()
+    {
+        std::tie(env, prog) = setup_compiler();
+        passes.dump_after = "reorder-branches";
+        passes.dump = &dump;
+        env.passes = &passes;
+    }
+
+    void ensure_compiled(const std::string& source)
+    {
+        const auto tokens = tokenize(source);
+        const auto parser = make_parser<ast::program>();
+        const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+        REQUIRE(is_success(parsed));
+        for (auto const& status : compile(prog, env, get_success(parsed).value))
+        {
+            REQUIRE(is_success(status));
+        }
+    }
+
+    std::vector<int32_t> run()
+    {
+        std::vector<int32_t> results;
+        for (auto& eval : prog.evaluations)
+        {
+            const auto result = execute(eval);
+            REQUIRE(holds<int32_t>(result));
+            results.push_back(get<int32_t>(result));
+        }
+        return results;
+    }
+};
+
+const std::string classify = R"(
+    (function classify i32 (i32 n)
+      (when [(= n (i32 0)) (i32 10)]
+            [(< n (i32 0)) (i32 20)]
+            [(> n (i32 100)) (i32 30)]
+            (i32 40)))
+    (function loop i32 (i32 n i32 acc)
+      (when [(= n (i32 0)) acc]
+            (loop (- n (i32 1)) (+ acc (classify (- n (i32 50)))))))
+    (loop (i32 200) (i32 0))
+)";
+
+}  // namespace
+
+TEST_CASE_FIXTURE(fixture, "dead branches with constant checks are removed")
+{
+    ensure_compiled(R"(
+        (function dead i32 (i32 n)
+          (when [(< (i32 1) (i32 0)) (i32 1)]
+                [(= n (i32 3)) (i32 2)]
+                [(> (i32 1) (i32 0)) (i32 3)]
+                (i32 4)))
+        (function constant i32 (i32 n)
+          (when [(= (i32 0) (i32 0)) n] (i32 0)))
+        (dead (i32 3))
+        (dead (i32 4))
+        (constant (i32 5))
+    )");
+    const auto ir = dump.str();
+    const auto dead = ir.substr(0, ir.find("(function constant"));
+    CHECK(dead.find("(i32 1)") == std::string::npos);
+    CHECK(dead.find("(i32 4)") == std::string::npos);
+    CHECK(ir.find("(function constant i32 (i32 %n)\n  %n)") != std::string::npos);
+    CHECK(run() == std::vector<int32_t>{2, 3, 5});
+}
+
+TEST_CASE_FIXTURE(fixture, "training counts the hits of every branch")
+{
+    branch_profile training;
+    env.training = &training;
+    ensure_compiled(classify);
+    CHECK(run() == std::vector<int32_t>{10 + 20 * 50 + 30 * 49 + 40 * 100});
+    const auto& hits = training.functions.at("classify(i32)");
+    REQUIRE(hits.size() == 1);
+    CHECK(hits.at(0) == branch_hits{1, 50, 49, 100});
+    CHECK(training.functions.at("loop(i32 i32)").at(0) == branch_hits{1, 200});
+}
+
+TEST_CASE_FIXTURE(fixture, "reorder exclusive branches by their hits")
+{
+    branch_profile profile;
+    profile.functions["classify(i32)"] = {{1, 50, 80, 99}};
+    env.profile = &profile;
+    ensure_compiled(classify);
+    const auto ir = dump.str();
+    const auto greater = ir.find("(>:bool %n (i32 100))");
+    const auto less = ir.find("(<:bool %n (i32 0))");
+    const auto equal = ir.find("(=:bool %n (i32 0))");
+    REQUIRE(greater != std::string::npos);
+    CHECK(greater < less);
+    CHECK(less < equal);
+    REQUIRE(profile.reorderings.size() == 1);
+    auto const& reordering = profile.reorderings.front();
+    CHECK(reordering.function == "classify(i32)");
+    CHECK(reordering.executions == 230);
+    CHECK(reordering.checks_before == 1 + 2 * 50 + 3 * 80 + 3 * 99);
+    CHECK(reordering.checks_after == 80 + 2 * 50 + 3 * 1 + 3 * 99);
+    CHECK(run() == std::vector<int32_t>{10 + 20 * 50 + 30 * 49 + 40 * 100});
+}
+
+TEST_CASE_FIXTURE(fixture, "overlapping branches keep their order")
+{
+    branch_profile profile;
+    profile.functions["bucket(i32)"] = {{1, 100, 100}};
+    env.profile = &profile;
+    ensure_compiled(R"(
+        (function bucket i32 (i32 n)
+          (when [(< n (i32 10)) (i32 1)]
+                [(< n (i32 20)) (i32 2)]
+                (i32 3)))
+        (bucket (i32 5))
+    )");
+    CHECK(profile.reorderings.empty());
+    CHECK(run() == std::vector<int32_t>{1});
+}
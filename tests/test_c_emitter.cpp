@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include "c_emitter.hpp"
+#include "compiler.hpp"
+#include "native_module.hpp"
+#include "parser.hpp"
+#include "tokenize.hpp"
+
+#include <filesystem>
+
+using namespace ant;
+
+namespace
+{
+
+struct compiled_source
+{
+    compiler_environment env;
+    runtime::program prog;
+    ast::program parsed;
+};
+
+compiled_source
+ensure_compiled(const std::string& source)
+{
+    const auto tokens = tokenize(source);
+    const auto parser = make_parser<ast::program>();
+    auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_success(parsed));
+    auto [env, prog] = setup_compiler();
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        REQUIRE(is_success(status));
+    }
+    return {std::move(env), std::move(prog), std::move(get_success(parsed).value)};
+}
+
+} // namespace
+
+TEST_CASE("emit C for evaluations and functions")
+{
+    const auto compiled = ensure_compiled(R"(
+        (function twice i32 (i32 x) (+ x x))
+        (twice (i32 21))
+        (< (f64 1.0) (f64 2.0))
+    )");
+    const auto emitted = emit_c(compiled.env, compiled.parsed);
+    REQUIRE(is_success(emitted));
+    const auto& source = get_success(emitted);
+    CHECK(source.find("ant_eval_0") != std::string::npos);
+    CHECK(source.find("ant_eval_1") != std::string::npos);
+    CHECK(source.find("ant_eval_count = 2") != std::string::npos);
+    CHECK(source.find("\"i32\"") != std::string::npos);
+    CHECK(source.find("\"bool\"") != std::string::npos);
+}
+
+TEST_CASE("emit C rejects structures")
+{
+    const auto compiled = ensure_compiled(R"(
+        (structure f64-pair f64 first f64 second)
+        (f64-pair (f64 1.0) (f64 2.0))
+    )");
+    CHECK(!is_success(emit_c(compiled.env, compiled.parsed)));
+}
+
+TEST_CASE("native modules evaluate programs like the tree walker")
+{
+    auto compiled = ensure_compiled(R"(
+        (function fib i32 (i32 n)
+          (when [(= n (i32 0)) (i32 1)]
+                [(= n (i32 1)) (i32 1)]
+                (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+
+        (function sum-impl-buggy i32 (i32 n i32 accum)
+          (when [(= n (i32 0)) accum]
+                (sum-impl-buggy (- n (i32 1)) (+ accum n))))
+
+        (function square-sum f64 (f64 x f64 y)
+          (let [xx (* x x)]
+               [yy (* y y)]
+               (+ xx yy)))
+
+        (fib (i32 15))
+        (sum-impl-buggy (i32 100) (i32 0))
+        (square-sum (f64 3.0) (f64 4.0))
+        (- (u8 0) (u8 1))
+        (/ (i32 1) (i32 0))
+    )");
+    const auto emitted = emit_c(compiled.env, compiled.parsed);
+    REQUIRE(is_success(emitted));
+
+    const auto cache = std::filesystem::temp_directory_path() / "antlang-test-native";
+    auto loaded = load_native_module(get_success(emitted), cache.string());
+    if (!is_success(loaded))
+    {
+        MESSAGE("Skipping native execution: " << get_failure(loaded));
+        return;
+    }
+    const auto& module = get_success(loaded);
+    REQUIRE(module.size() == compiled.prog.evaluations.size());
+    for (size_t i = 0; i + 1 < module.size(); ++i)
+    {
+        const auto expected = execute(compiled.prog.evaluations.at(i));
+        const auto result = module.execute(i);
+        REQUIRE(result.storage.index() == expected.storage.index());
+        if (holds<int32_t>(expected))
+        {
+            CHECK(get<int32_t>(result) == get<int32_t>(expected));
+        }
+        else if (holds<uint8_t>(expected))
+        {
+            CHECK(get<uint8_t>(result) == get<uint8_t>(expected));
+        }
+        else
+        {
+            CHECK(get<flt64_t>(result) == get<flt64_t>(expected));
+        }
+    }
+    CHECK_THROWS_AS(module.execute(module.size() - 1), runtime::arithmetic_error);
+}
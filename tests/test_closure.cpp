@@ -0,0 +1,175 @@
+#include <doctest/doctest.h>
+
+#include "closure.hpp"
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "tokenize.hpp"
+
+using namespace ant;
+
+namespace
+{
+
+runtime::program
+ensure_compiled(const std::string& source)
+{
+    const auto tokens = tokenize(source);
+    const auto parser = make_parser<ast::program>();
+    const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_success(parsed));
+    auto [env, prog] = setup_compiler();
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        REQUIRE(is_success(status));
+    }
+    return std::move(prog);
+}
+
+} // namespace
+
+TEST_CASE("execute closure of literal value")
+{
+    runtime::closure_program prog;
+    runtime::expression expr = runtime::value_variant{int32_t{1337}};
+    const runtime::closure compiled = compile_closure(prog, expr);
+    const runtime::value_variant result = execute(compiled);
+    REQUIRE(holds<int32_t>(result));
+    CHECK(get<int32_t>(result) == 1337);
+}
+
+TEST_CASE("execute closure of scope restores binding results")
+{
+    runtime::closure_program prog;
+    runtime::scope let;
+    let.bindings.push_back({int32_t{13}, int32_t{37}});
+    let.value = &let.bindings.at(0).result;
+    runtime::expression expr = std::make_unique<runtime::scope>(std::move(let));
+    const runtime::closure compiled = compile_closure(prog, expr);
+    const runtime::value_variant result = execute(compiled);
+    REQUIRE(holds<int32_t>(result));
+    CHECK(get<int32_t>(result) == 37);
+    auto const& bindings = get<std::unique_ptr<runtime::scope>>(expr)->bindings;
+    CHECK(get<int32_t>(bindings.at(0).result) == 13);
+}
+
+TEST_CASE("closures evaluate programs like the tree walker")
+{
+    const std::string source = R"(
+        (function fib i32 (i32 n)
+          (when [(= n (i32 0)) (i32 1)]
+                [(= n (i32 1)) (i32 1)]
+                (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+
+        (function sum-impl i32 (i32 accum i32 n)
+          (when [(= n (i32 0)) accum]
+                (sum-impl (+ accum n) (- n (i32 1)))))
+
+        (function sum-impl-buggy i32 (i32 n i32 accum)
+          (when [(= n (i32 0)) accum]
+                (sum-impl-buggy (- n (i32 1)) (+ accum n))))
+
+        (function square-sum f64 (f64 x f64 y)
+          (let [xx (* x x)]
+               [yy (* y y)]
+               (+ xx yy)))
+
+        (structure f64-pair f64 first f64 second)
+
+        (fib (i32 15))
+        (sum-impl (i32 0) (i32 100))
+        (sum-impl-buggy (i32 100) (i32 0))
+        (square-sum (f64 3.0) (f64 4.0))
+        (f64-pair (f64 1.0) (square-sum (f64 1.0) (f64 2.0)))
+    )";
+    auto prog = ensure_compiled(source);
+    const auto closures = runtime::compile_closures(prog);
+    REQUIRE(closures.evaluations.size() == prog.evaluations.size());
+    for (size_t i = 0; i < prog.evaluations.size(); ++i)
+    {
+        const auto expected = execute(prog.evaluations.at(i));
+        const auto result = execute(closures.evaluations.at(i));
+        CHECK(result.storage.index() == expected.storage.index());
+        if (holds<runtime::structure>(expected))
+        {
+            const auto& fields = get<runtime::structure>(result).fields;
+            const auto& expected_fields = get<runtime::structure>(expected).fields;
+            REQUIRE(fields.size() == expected_fields.size());
+            for (size_t j = 0; j < fields.size(); ++j)
+            {
+                CHECK(get<flt64_t>(fields.at(j)) == get<flt64_t>(expected_fields.at(j)));
+            }
+        }
+        else if (holds<int32_t>(expected))
+        {
+            CHECK(get<int32_t>(result) == get<int32_t>(expected));
+        }
+        else
+        {
+            CHECK(get<flt64_t>(result) == get<flt64_t>(expected));
+        }
+    }
+}
+
+TEST_CASE("tiering promotes hot functions to closures")
+{
+    const std::string source = R"(
+        (function fib i32 (i32 n)
+          (when [(= n (i32 0)) (i32 1)]
+                [(= n (i32 1)) (i32 1)]
+                (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+
+        (function sum-impl-buggy i32 (i32 n i32 accum)
+          (when [(= n (i32 0)) accum]
+                (sum-impl-buggy (- n (i32 1)) (+ accum n))))
+
+        (fib (i32 15))
+        (sum-impl-buggy (i32 100) (i32 0))
+    )";
+    auto reference = ensure_compiled(source);
+    auto prog = ensure_compiled(source);
+    runtime::tiering tier;
+    tier.threshold = 10;
+    runtime::enable_tiering(prog, tier);
+    for (auto const& func : prog.functions)
+    {
+        CHECK(func->promoted == nullptr);
+    }
+    for (size_t i = 0; i < prog.evaluations.size(); ++i)
+    {
+        const auto expected = execute(reference.evaluations.at(i));
+        const auto result = execute(prog.evaluations.at(i));
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == get<int32_t>(expected));
+    }
+    size_t promoted = 0;
+    for (auto const& func : prog.functions)
+    {
+        if (func->promoted)
+        {
+            ++promoted;
+            CHECK(func->calls == tier.threshold);
+            CHECK(!holds<runtime::operation>(func->value));
+        }
+    }
+    CHECK(promoted == 2);
+}
+
+TEST_CASE("tiering keeps cold functions in the tree walker")
+{
+    auto prog = ensure_compiled(R"(
+        (function twice i32 (i32 x) (+ x x))
+        (twice (i32 1))
+        (twice (i32 2))
+    )");
+    runtime::tiering tier;
+    runtime::enable_tiering(prog, tier);
+    for (auto& eval : prog.evaluations)
+    {
+        execute(eval);
+    }
+    for (auto const& func : prog.functions)
+    {
+        CHECK(func->promoted == nullptr);
+    }
+    CHECK(tier.closures.bodies.empty());
+}
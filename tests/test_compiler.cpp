@@ -508,7 +508,7 @@ TEST_CASE_FIXTURE(fixture, "arithmetic operations are defined as expected")
     {
         auto func_query = find_function(env, "+", {"i32", "i32"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, plus] = get_success(func_query);
+        auto& [return_type, plus, inlining] = get_success(func_query);
         REQUIRE(plus->parameters.size() == 2);
         CHECK(holds<int32_t>(plus->parameters.at(0)));
         CHECK(holds<int32_t>(plus->parameters.at(1)));
@@ -520,7 +520,7 @@ TEST_CASE_FIXTURE(fixture, "arithmetic operations are defined as expected")
     {
         auto func_query = find_function(env, "+", {"i64", "i64"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, plus] = get_success(func_query);
+        auto& [return_type, plus, inlining] = get_success(func_query);
         REQUIRE(plus->parameters.size() == 2);
         CHECK(holds<int64_t>(plus->parameters.at(0)));
         CHECK(holds<int64_t>(plus->parameters.at(1)));
@@ -532,7 +532,7 @@ TEST_CASE_FIXTURE(fixture, "arithmetic operations are defined as expected")
     {
         auto func_query = find_function(env, "-", {"u8", "u8"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, minus] = get_success(func_query);
+        auto& [return_type, minus, inlining] = get_success(func_query);
         REQUIRE(minus->parameters.size() == 2);
         CHECK(holds<uint8_t>(minus->parameters.at(0)));
         CHECK(holds<uint8_t>(minus->parameters.at(1)));
@@ -544,7 +544,7 @@ TEST_CASE_FIXTURE(fixture, "arithmetic operations are defined as expected")
     {
         auto func_query = find_function(env, "*", {"u16", "u16"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, mult] = get_success(func_query);
+        auto& [return_type, mult, inlining] = get_success(func_query);
         REQUIRE(mult->parameters.size() == 2);
         CHECK(holds<uint16_t>(mult->parameters.at(0)));
         CHECK(holds<uint16_t>(mult->parameters.at(1)));
@@ -556,7 +556,7 @@ TEST_CASE_FIXTURE(fixture, "arithmetic operations are defined as expected")
     {
         auto func_query = find_function(env, "/", {"f32", "f32"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, div] = get_success(func_query);
+        auto& [return_type, div, inlining] = get_success(func_query);
         REQUIRE(div->parameters.size() == 2);
         CHECK(holds<flt32_t>(div->parameters.at(0)));
         CHECK(holds<flt32_t>(div->parameters.at(1)));
@@ -572,7 +572,7 @@ TEST_CASE_FIXTURE(fixture, "comparison operations are defined as expected")
     {
         auto func_query = find_function(env, "=", {"u32", "u32"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, equals] = get_success(func_query);
+        auto& [return_type, equals, inlining] = get_success(func_query);
         REQUIRE(equals->parameters.size() == 2);
         CHECK(holds<uint32_t>(equals->parameters.at(0)));
         CHECK(holds<uint32_t>(equals->parameters.at(1)));
@@ -584,7 +584,7 @@ TEST_CASE_FIXTURE(fixture, "comparison operations are defined as expected")
     {
         auto func_query = find_function(env, "<", {"f64", "f64"});
         REQUIRE(is_success(func_query));
-        auto& [return_type, less] = get_success(func_query);
+        auto& [return_type, less, inlining] = get_success(func_query);
         REQUIRE(less->parameters.size() == 2);
         CHECK(holds<flt64_t>(less->parameters.at(0)));
         CHECK(holds<flt64_t>(less->parameters.at(1)));
@@ -633,3 +633,63 @@ TEST_CASE_FIXTURE(fixture, "compile recursive function")
     REQUIRE(meta.parameter_types.size() == 1);
     CHECK(meta.parameter_types.at(0) == "i32");
 }
+
+TEST_CASE_FIXTURE(fixture, "compile operation on parameter and literal fuses into superinstruction")
+{
+    const ast::function func =
+    {
+        "decrement",
+        ast::reference{"i32"},
+        {
+            {"i32", "n"}
+        },
+        ast::evaluation{"-", {ast::reference{"n"}, ast::literal<int32_t>{1}}}
+    };
+    const auto result = compile(env, func);
+    REQUIRE(is_success(result));
+    const auto& [meta, compiled] = get_success(result);
+    REQUIRE(holds<runtime::slot_constant_operation>(compiled->value));
+    const auto& op = get<runtime::slot_constant_operation>(compiled->value);
+    CHECK(op.lhs == &compiled->parameters.at(0));
+    compiled->parameters.at(0) = int32_t{1337};
+    const auto value = runtime::execute(*compiled);
+    REQUIRE(holds<int32_t>(value));
+    CHECK(get<int32_t>(value) == 1336);
+}
+
+TEST_CASE_FIXTURE(fixture, "compile condition comparing parameter with literal fuses into guards")
+{
+    const ast::expression is_zero =
+        ast::evaluation{"=", {ast::reference{"n"}, ast::literal<int32_t>{0}}};
+    const ast::expression is_one =
+        ast::evaluation{"=", {ast::reference{"n"}, ast::literal<int32_t>{1}}};
+    const ast::function func =
+    {
+        "classify",
+        ast::reference{"i32"},
+        {
+            {"i32", "n"}
+        },
+        ast::condition{
+            {
+                {is_zero, ast::literal<int32_t>{13}},
+                {is_one, ast::literal<int32_t>{37}}
+            },
+            ast::expression{ast::literal<int32_t>{1337}}
+        }
+    };
+    const auto result = compile(env, func);
+    REQUIRE(is_success(result));
+    const auto& [meta, compiled] = get_success(result);
+    REQUIRE(holds<runtime::guard>(compiled->value));
+    const auto& outer = get<runtime::guard>(compiled->value);
+    CHECK(outer.slot == &compiled->parameters.at(0));
+    CHECK(holds<runtime::guard>(outer.fallback));
+    for (const auto& [argument, expected] : {std::pair{0, 13}, {1, 37}, {2, 1337}})
+    {
+        compiled->parameters.at(0) = int32_t{argument};
+        const auto value = runtime::execute(*compiled);
+        REQUIRE(holds<int32_t>(value));
+        CHECK(get<int32_t>(value) == expected);
+    }
+}
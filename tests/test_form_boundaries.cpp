@@ -0,0 +1,32 @@
+#include <doctest/doctest.h>
+
+#include "form_boundaries.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ant;
+
+TEST_CASE("sources split at lines outside of top-level forms")
+{
+    const std::string source =
+        "(f (i32 1))\n"
+        "(function g i32 (i32 x)\n"
+        "  ; a comment ) with brackets (\n"
+        "  x)\n"
+        "(g (i32 2))\n";
+    const size_t second = source.find("(function");
+    const size_t third = source.find("(g");
+
+    CHECK(split_at_forms(source, 1) == std::vector<size_t>{0, source.size()});
+    CHECK(split_at_forms(source, 2) == std::vector<size_t>{0, third, source.size()});
+    CHECK(split_at_forms(source, 3) == std::vector<size_t>{0, third, source.size()});
+    CHECK(split_at_forms(source, 10) == std::vector<size_t>{0, second, third, source.size()});
+    CHECK(split_at_forms("", 4) == std::vector<size_t>{0, 0});
+}
+
+TEST_CASE("unbalanced closing brackets do not prevent splitting")
+{
+    const std::string source = "(f))\n(g)\n(h\n)\n";
+    CHECK(split_at_forms(source, 10) == std::vector<size_t>{0, 5, 9, source.size()});
+}
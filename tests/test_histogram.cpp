@@ -0,0 +1,40 @@
+#include <doctest/doctest.h>
+
+#include "histogram.hpp"
+
+using namespace ant;
+using namespace ant::runtime;
+
+TEST_CASE("histogram counts nested nodes of function bodies and evaluations")
+{
+    program prog;
+    prog.functions.push_back(std::make_unique<function>());
+    function& func = *prog.functions.back();
+    func.parameters = {int32_t{}};
+    func.value = slot_constant_operation{
+        apply_binary_operator<plus, int32_t>,
+        &func.parameters.at(0),
+        int32_t{1}
+    };
+
+    evaluation eval(&func);
+    eval.arguments.at(0) = int32_t{1337};
+    prog.evaluations.push_back(std::move(eval));
+
+    const node_histogram histogram = make_histogram(prog);
+    CHECK(histogram.size() == 3);
+    CHECK(histogram.at("slot-constant-operation") == 1);
+    CHECK(histogram.at("evaluation(value)") == 1);
+    CHECK(histogram.at("value") == 1);
+}
+
+TEST_CASE("histogram skips built-in operations")
+{
+    program prog;
+    prog.functions.push_back(std::make_unique<function>());
+    function& op = *prog.functions.back();
+    op.parameters = {int32_t{}, int32_t{}};
+    op.value = make_binary_operator<plus, int32_t>(&op);
+
+    CHECK(make_histogram(prog).empty());
+}
@@ -0,0 +1,197 @@
+#include <doctest/doctest.h>
+
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "passes.hpp"
+#include "tokenize.hpp"
+
+#include <sstream>
+
+using namespace ant;
+
+namespace
+{
+
+struct fixture
+{
+    compiler_environment env;
+    compiler_scope scope;
+    runtime::program prog;
+
+    fixture()
+    {
+        std::tie(env, prog) = setup_compiler();
+    }
+
+    void ensure_compiled(const std::string& source)
+    {
+        const auto tokens = tokenize(source);
+        const auto parser = make_parser<ast::program>();
+        const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+        REQUIRE(is_success(parsed));
+        for (auto const& status : compile(prog, env, get_success(parsed).value))
+        {
+            REQUIRE(is_success(status));
+        }
+    }
+};
+
+ast::expression add(ast::expression lhs, ast::expression rhs)
+{
+    return ast::evaluation{"+", {std::move(lhs), std::move(rhs)}};
+}
+
+}  // namespace
+
+TEST_CASE_FIXTURE(fixture, "translate let numbers its locals uniquely")
+{
+    const ast::scope inner = {
+        {{"y", ast::literal<int32_t>{2}}},
+        add(ast::reference{"x"}, ast::reference{"y"})
+    };
+    const ast::scope outer = {
+        {{"x", ast::literal<int32_t>{1}}},
+        ast::expression{inner}
+    };
+    const auto result = translate(env, scope, outer);
+    REQUIRE(is_success(result));
+    const auto& [let, type] = get_success(result);
+    CHECK(type == "i32");
+    CHECK(let.type == "i32");
+    REQUIRE(let.bindings.size() == 1);
+    REQUIRE(holds<ir::scope>(let.value.get()));
+    const auto& nested = get<ir::scope>(let.value.get());
+    REQUIRE(nested.bindings.size() == 1);
+    CHECK(let.bindings.at(0).id != nested.bindings.at(0).id);
+    REQUIRE(holds<ir::call>(nested.value.get()));
+    const auto& sum = get<ir::call>(nested.value.get());
+    CHECK(ir::is_operation(sum));
+    REQUIRE(holds<ir::local>(sum.arguments.at(0)));
+    REQUIRE(holds<ir::local>(sum.arguments.at(1)));
+    CHECK(get<ir::local>(sum.arguments.at(0)).id == let.bindings.at(0).id);
+    CHECK(get<ir::local>(sum.arguments.at(1)).id == nested.bindings.at(0).id);
+    CHECK(*scope.local_count == 2);
+}
+
+TEST_CASE_FIXTURE(fixture, "translate let rejects shadowing of locals")
+{
+    const ast::scope inner = {{{"x", ast::literal<int32_t>{2}}}, ast::expression{ast::reference{"x"}}};
+    const ast::scope outer = {{{"x", ast::literal<int32_t>{1}}}, ast::expression{inner}};
+    CHECK(is_failure(translate(env, scope, outer)));
+}
+
+TEST_CASE_FIXTURE(fixture, "fold constants of operations and let bindings")
+{
+    const ast::scope let = {
+        {
+            {"x", add(ast::literal<int32_t>{1}, ast::literal<int32_t>{2})},
+            {"y", ast::evaluation{"/", {ast::literal<int32_t>{1}, ast::literal<int32_t>{0}}}}
+        },
+        add(ast::reference{"x"}, ast::reference{"y"})
+    };
+    auto result = translate(env, scope, let);
+    REQUIRE(is_success(result));
+    ir::function func;
+    func.body = std::move(get_success(result).value);
+    fold_constants(env, func);
+
+    REQUIRE(holds<ir::scope>(func.body));
+    const auto& folded = get<ir::scope>(func.body);
+    REQUIRE(folded.bindings.size() == 1);
+    CHECK(folded.bindings.at(0).name == "y");
+    CHECK(holds<ir::call>(folded.bindings.at(0).value));
+    REQUIRE(holds<ir::call>(folded.value.get()));
+    const auto& sum = get<ir::call>(folded.value.get());
+    REQUIRE(holds<ir::constant>(sum.arguments.at(0)));
+    CHECK(get<int32_t>(get<ir::constant>(sum.arguments.at(0)).value) == 3);
+    CHECK(holds<ir::local>(sum.arguments.at(1)));
+}
+
+TEST_CASE("pass manager selects passes by optimization level")
+{
+    CHECK(make_pass_manager(0).pipeline.empty());
+    const auto manager = make_pass_manager(max_optimization_level);
+    CHECK(manager.pipeline.size() == optimization_passes().size());
+    CHECK(manager.timings.size() == manager.pipeline.size());
+    CHECK(find_pass("fold"));
+    CHECK(!find_pass("no-such-pass"));
+}
+
+TEST_CASE_FIXTURE(fixture, "pass manager times passes and dumps the ir after a pass")
+{
+    std::stringstream dump;
+    pass_manager manager = make_pass_manager(1);
+    manager.dump_after = "fold";
+    manager.dump = &dump;
+    env.passes = &manager;
+    ensure_compiled(R"(
+        (function twice i32 (i32 x) (+ x x))
+        (twice (+ (i32 1) (i32 2)))
+        (* (i32 6) (i32 7))
+    )");
+    REQUIRE(!manager.timings.empty());
+    CHECK(manager.timings.at(0).name == "fold");
+    CHECK(manager.timings.at(0).runs == 3);
+    CHECK(dump.str().find("(function twice i32 (i32 %x)") != std::string::npos);
+    CHECK(dump.str().find("(twice:i32 (i32 3))") != std::string::npos);
+
+    REQUIRE(prog.evaluations.size() == 2);
+    const auto twice = execute(prog.evaluations.at(0));
+    REQUIRE(holds<int32_t>(twice));
+    CHECK(get<int32_t>(twice) == 6);
+    const auto product = execute(prog.evaluations.at(1));
+    REQUIRE(holds<int32_t>(product));
+    CHECK(get<int32_t>(product) == 42);
+}
+
+TEST_CASE_FIXTURE(fixture, "find function reports the inlining decision")
+{
+    ensure_compiled(R"(
+        (function twice i32 (i32 x) (+ x x))
+        (function fib i32 (i32 n)
+          (when [(= n (i32 0)) (i32 1)]
+                [(= n (i32 1)) (i32 1)]
+                (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+        (function poly i32 (i32 x)
+          (+ (* x (* x x)) (+ (* x x) (+ x (i32 1)))))
+    )");
+    const auto twice = find_function(env, "twice", {"i32"});
+    REQUIRE(is_success(twice));
+    CHECK(get_success(twice).inlining.inlinable);
+    CHECK(get_success(twice).inlining.body);
+    const auto fib = find_function(env, "fib", {"i32"});
+    REQUIRE(is_success(fib));
+    CHECK(!get_success(fib).inlining.inlinable);
+    CHECK(get_success(fib).inlining.reason == "recursive");
+    const auto poly = find_function(env, "poly", {"i32"});
+    REQUIRE(is_success(poly));
+    CHECK(!get_success(poly).inlining.inlinable);
+    CHECK(get_success(poly).inlining.reason.find("exceeds") != std::string::npos);
+    const auto plus = find_function(env, "+", {"i32", "i32"});
+    REQUIRE(is_success(plus));
+    CHECK(get_success(plus).inlining.reason == "built-in operation");
+}
+
+TEST_CASE_FIXTURE(fixture, "inline calls keeps the let scoping of inlined bodies")
+{
+    std::stringstream dump;
+    pass_manager manager = make_pass_manager(2);
+    manager.dump_after = "inline";
+    manager.dump = &dump;
+    env.passes = &manager;
+    ensure_compiled(R"(
+        (function square-sum f64 (f64 x f64 y)
+          (let [xx (* x x)]
+               [yy (* y y)]
+               (+ xx yy)))
+        (function hyp f64 (f64 a)
+          (let [xx (+ a a)]
+               (square-sum xx (+ xx a))))
+        (hyp (f64 3.0))
+    )");
+    CHECK(dump.str().find("square-sum:") == std::string::npos);
+    REQUIRE(prog.evaluations.size() == 1);
+    const auto result = execute(prog.evaluations.at(0));
+    REQUIRE(holds<flt64_t>(result));
+    CHECK(get<flt64_t>(result) == 117.0);
+}
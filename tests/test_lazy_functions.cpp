@@ -0,0 +1,132 @@
+#include <doctest/doctest.h>
+
+#include "compiler.hpp"
+#include "lazy_functions.hpp"
+#include "parser.hpp"
+#include "tokenize.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ant;
+
+namespace
+{
+
+const std::string source = R"(
+    (function square i32 (i32 x) (* x x))
+    (function unused i32 (i32 x) (+ x (i32 1)))
+    (function sum i32 (i32 n)
+      (when
+        [(= n (i32 0)) (i32 0)]
+        (+ (square n) (sum (- n (i32 1))))
+      )
+    )
+    (sum (i32 4))
+)";
+
+std::vector<int32_t> run(runtime::program& prog)
+{
+    std::vector<int32_t> results;
+    for (auto& eval : prog.evaluations)
+    {
+        const auto result = execute(eval);
+        REQUIRE(holds<int32_t>(result));
+        results.push_back(get<int32_t>(result));
+    }
+    return results;
+}
+
+std::vector<compiler_status>
+compile_lazily(runtime::program& prog, compiler_environment& env, lazy_functions& lazy, token_stream const& tokens)
+{
+    const auto parsed = parse_lazily(tokens);
+    REQUIRE(is_success(parsed));
+    env.lazy = &lazy;
+    return compile(prog, env, get_success(parsed).value);
+}
+
+} // namespace
+
+TEST_CASE("functions parse without their bodies")
+{
+    const auto tokens = tokenize(source);
+    const auto parsed = parse_lazily(tokens);
+    REQUIRE(is_success(parsed));
+    auto const& statements = get_success(parsed).value.statements;
+    REQUIRE(statements.size() == 4);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto const& function = get<ast::function>(statements.at(i));
+        REQUIRE(function.deferred_body.has_value());
+        CHECK(function.deferred_body->tokens == &tokens);
+        CHECK(holds<right_parenthesis_token>(tokens.at(function.deferred_body->end)));
+    }
+    CHECK(get<ast::function>(statements.at(0)).name == "square");
+    CHECK(holds<ast::evaluation>(statements.at(3)));
+
+    const auto body = parse_body(get<ast::function>(statements.at(0)));
+    REQUIRE(is_success(body));
+    CHECK_FALSE(get_success(body).deferred_body.has_value());
+}
+
+TEST_CASE("deferred bodies compile on the first call only")
+{
+    const auto tokens = tokenize(source);
+    auto [env, prog] = setup_compiler();
+    lazy_functions lazy;
+    for (auto const& status : compile_lazily(prog, env, lazy, tokens))
+    {
+        REQUIRE(is_success(status));
+    }
+    CHECK(lazy.deferred() == 3);
+    CHECK(lazy.compiled() == 2);
+    CHECK(run(prog) == std::vector<int32_t>{30});
+}
+
+TEST_CASE("deferred functions compile eagerly without lazy functions")
+{
+    const auto tokens = tokenize(source);
+    const auto parsed = parse_lazily(tokens);
+    REQUIRE(is_success(parsed));
+    auto [env, prog] = setup_compiler();
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        REQUIRE(is_success(status));
+    }
+    CHECK(run(prog) == std::vector<int32_t>{30});
+}
+
+TEST_CASE("deferred bodies only call functions defined before them")
+{
+    const auto tokens = tokenize(R"(
+        (function f i32 (i32 x) (g x))
+        (function g i32 (i32 x) x)
+        (f (i32 1))
+    )");
+    auto [env, prog] = setup_compiler();
+    lazy_functions lazy;
+    const auto statuses = compile_lazily(prog, env, lazy, tokens);
+    REQUIRE(statuses.size() == 3);
+    REQUIRE(is_failure(statuses.at(2)));
+    CHECK(get_failure(statuses.at(2)).message.find("'g'") != std::string::npos);
+}
+
+TEST_CASE("deferred bodies fail to parse on the first call")
+{
+    const auto tokens = tokenize(R"(
+        (function broken i32 (i32 x) (+ x) x)
+        (function unused i32 (i32 x) (x x])
+        (broken (i32 1))
+    )");
+    auto [env, prog] = setup_compiler();
+    lazy_functions lazy;
+    const auto statuses = compile_lazily(prog, env, lazy, tokens);
+    REQUIRE(statuses.size() == 3);
+    CHECK(is_success(statuses.at(0)));
+    CHECK(is_success(statuses.at(1)));
+    REQUIRE(is_failure(statuses.at(2)));
+    auto const& failure = get_failure(statuses.at(2));
+    CHECK(failure.message.find("Failed to parse the body of function 'broken'") == 0);
+    CHECK(failure.context.line == 2);
+}
@@ -0,0 +1,30 @@
+#include <doctest/doctest.h>
+
+#include "parallel.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace ant;
+
+TEST_CASE("parallel for runs every task once")
+{
+    for (size_t threads : {1, 4})
+    {
+        std::vector<int> runs(100, 0);
+        parallel_for(runs.size(), threads, [&runs](size_t i) { runs[i] += 1; });
+        CHECK(runs == std::vector<int>(100, 1));
+    }
+    CHECK(hardware_threads() >= 1);
+}
+
+TEST_CASE("parallel for rethrows exceptions of tasks")
+{
+    CHECK_THROWS_AS(parallel_for(10, 3, [](size_t i) {
+                        if (i == 7)
+                        {
+                            throw std::runtime_error("task failed");
+                        }
+                    }),
+                    std::runtime_error);
+}
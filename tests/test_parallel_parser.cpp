@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include "parallel_parser.hpp"
+#include "parser.hpp"
+#include "program_generator.hpp"
+#include "tokenize.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ant;
+
+namespace
+{
+
+void check_same_failures(parser_failure const& lhs, parser_failure const& rhs)
+{
+    CHECK(lhs.message == rhs.message);
+    CHECK(lhs.position == rhs.position);
+    REQUIRE(lhs.children.size() == rhs.children.size());
+    for (size_t i = 0; i < lhs.children.size(); ++i)
+    {
+        check_same_failures(lhs.children.at(i), rhs.children.at(i));
+    }
+}
+
+std::string generated_source()
+{
+    generator_options options;
+    options.functions = 150;
+    return generate_program(options);
+}
+
+} // namespace
+
+TEST_CASE("programs split into parts at statements")
+{
+    const auto tokens = tokenize("(f (i32 1))\n(g [x])\n)\n(h)");
+    CHECK(split_at_statements(tokens, 1) == std::vector<size_t>{0, 17});
+    CHECK(split_at_statements(tokens, 3) == std::vector<size_t>{0, 7, 13, 17});
+    CHECK(split_at_statements(tokens, 10) == std::vector<size_t>{0, 7, 13, 14, 17});
+}
+
+TEST_CASE("programs parse to the same statements on several threads")
+{
+    const auto tokens = tokenize(generated_source());
+    const auto expected = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    const auto parsed = parse_program(tokens, 4);
+    REQUIRE(is_success(expected));
+    REQUIRE(is_success(parsed));
+    auto const& statements = get_success(parsed).value.statements;
+    auto const& expected_statements = get_success(expected).value.statements;
+    REQUIRE(statements.size() == expected_statements.size());
+    for (size_t i = 0; i < statements.size(); ++i)
+    {
+        CHECK(statements.at(i).storage.index() == expected_statements.at(i).storage.index());
+        CHECK(get_context(statements.at(i)).line == get_context(expected_statements.at(i)).line);
+    }
+    CHECK(get_success(parsed).position == tokens.cend());
+}
+
+TEST_CASE("programs fail to parse on several threads as on a single one")
+{
+    std::string source = generated_source();
+    // malformed statements in the middle and at the end of the source
+    source.insert(source.size() / 2, "\n(function broken (i32 x) x)\n(+ (i32 1)\n  (f64 2))\n");
+    source += "(f (i32 1)";
+    const auto tokens = tokenize(source);
+    const auto expected = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    const auto parsed = parse_program(tokens, 4);
+    REQUIRE(is_failure(expected));
+    REQUIRE(is_failure(parsed));
+    check_same_failures(get_failure(parsed), get_failure(expected));
+}
@@ -0,0 +1,177 @@
+#include <doctest/doctest.h>
+
+#include "closure.hpp"
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "profile.hpp"
+#include "tokenize.hpp"
+
+#include <sstream>
+
+using namespace ant;
+
+namespace
+{
+
+struct fixture
+{
+    compiler_environment env;
+    runtime::program prog;
+
+    fixture()
+    {
+        std::tie(env, prog) = setup_compiler();
+    }
+
+    void ensure_compiled(const std::string& source)
+    {
+        const auto tokens = tokenize(source);
+        const auto parser = make_parser<ast::program>();
+        const auto parsed = parser.parse(tokens.cbegin(), tokens.cend());
+        REQUIRE(is_success(parsed));
+        for (auto const& status : compile(prog, env, get_success(parsed).value))
+        {
+            REQUIRE(is_success(status));
+        }
+    }
+};
+
+const std::string fib = R"(
+    (function fib i32 (i32 n)
+      (when [(< n (i32 2)) (i32 1)]
+            (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))
+    (function unused i32 (i32 n) n)
+    (fib (i32 10))
+)";
+
+}  // namespace
+
+TEST_CASE("profiles are written and read back")
+{
+    program_profile profile;
+    profile.functions["fib(i32)"] = {177, std::chrono::nanoseconds(4812)};
+    profile.functions["loop(i32 i32)"] = {11, std::chrono::nanoseconds(0)};
+    profile.branches.functions["loop(i32 i32)"] = {{1, 10}, {0, 3, 7}};
+    std::stringstream file;
+    write_profile(file, profile);
+    CHECK(file.str() ==
+          "antlang-profile 1\n"
+          "function fib(i32) calls 177 inclusive-ns 4812\n"
+          "function loop(i32 i32) calls 11 inclusive-ns 0\n"
+          "condition loop(i32 i32) 0 hits 1 10\n"
+          "condition loop(i32 i32) 1 hits 0 3 7\n");
+    const auto read = read_profile(file);
+    REQUIRE(is_success(read));
+    auto const& loaded = get_success(read);
+    CHECK(loaded.functions.at("fib(i32)").calls == 177);
+    CHECK(loaded.functions.at("fib(i32)").inclusive.count() == 4812);
+    CHECK(loaded.functions.at("loop(i32 i32)").calls == 11);
+    CHECK(loaded.branches.functions == profile.branches.functions);
+}
+
+TEST_CASE("reading a malformed profile fails with its line")
+{
+    std::stringstream version("antlang-profile 0\n");
+    CHECK(is_failure(read_profile(version)));
+    std::stringstream line("antlang-profile 1\nfunction fib(i32) calls many\n");
+    const auto read = read_profile(line);
+    REQUIRE(is_failure(read));
+    CHECK(get_failure(read) == "Invalid profile line 2: function fib(i32) calls many");
+}
+
+TEST_CASE_FIXTURE(fixture, "profiled functions count their calls in every engine")
+{
+    runtime::profiler profiler;
+    branch_profile branches;
+    env.profiler = &profiler;
+    env.training = &branches;
+    ensure_compiled(fib);
+
+    SUBCASE("tree")
+    {
+        CHECK(get<int32_t>(execute(prog.evaluations.front())) == 89);
+    }
+    SUBCASE("closure")
+    {
+        const auto closures = runtime::compile_closures(prog);
+        CHECK(get<int32_t>(execute(closures.evaluations.front())) == 89);
+    }
+
+    CHECK(profiler.frames.empty());
+    auto const& profile = profiler.functions.at("fib(i32)");
+    CHECK(profile.calls == 177);
+    CHECK(profile.depth == 0);
+    CHECK(profile.exclusive <= profile.inclusive);
+    CHECK(profiler.functions.at("unused(i32)").calls == 0);
+    CHECK(branches.functions.at("fib(i32)").at(0) == branch_hits{89, 88});
+
+    const auto recorded = make_profile(profiler, branches);
+    CHECK(recorded.functions.at("fib(i32)").calls == 177);
+    CHECK(recorded.functions.at("fib(i32)").inclusive == profile.inclusive);
+}
+
+TEST_CASE_FIXTURE(fixture, "recorded calls guide inlining")
+{
+    program_profile recorded;
+    recorded.functions["poly(i32)"] = {hot_call_count, {}};
+    recorded.functions["twice(i32)"] = {0, {}};
+    env.recorded = &recorded;
+    ensure_compiled(R"(
+        (function twice i32 (i32 x) (+ x x))
+        (function poly i32 (i32 x)
+          (+ (* x (* x x)) (+ (* x x) (+ x (i32 1)))))
+        (function square i32 (i32 x) (* x x))
+    )");
+    const auto twice = find_function(env, "twice", {"i32"});
+    REQUIRE(is_success(twice));
+    CHECK(!get_success(twice).inlining.inlinable);
+    CHECK(get_success(twice).inlining.reason == "not called in the profile");
+    const auto poly = find_function(env, "poly", {"i32"});
+    REQUIRE(is_success(poly));
+    CHECK(get_success(poly).inlining.inlinable);
+    CHECK(get_success(poly).inlining.reason == "hot body of 13 nodes within the limit of 24");
+    const auto square = find_function(env, "square", {"i32"});
+    REQUIRE(is_success(square));
+    CHECK(get_success(square).inlining.inlinable);
+}
+
+TEST_CASE_FIXTURE(fixture, "profiler attributes exclusive time to call stacks")
+{
+    runtime::profiler profiler;
+    env.profiler = &profiler;
+    ensure_compiled(R"(
+        (function leaf i32 (i32 n) (* n n))
+        (function middle i32 (i32 n) (+ (leaf n) (leaf (+ n (i32 1)))))
+        (function top i32 (i32 n) (+ (middle n) (leaf n)))
+        (top (i32 3))
+    )");
+    CHECK(get<int32_t>(execute(prog.evaluations.front())) == 9 + 16 + 9);
+    CHECK(profiler.functions.at("leaf(i32)").calls == 3);
+    CHECK(profiler.functions.at("middle(i32)").calls == 1);
+
+    // top, top;middle, top;middle;leaf and top;leaf
+    REQUIRE(profiler.stacks.size() == 5);
+    std::chrono::nanoseconds exclusive{0};
+    for (auto const& stack : profiler.stacks)
+    {
+        exclusive += stack.exclusive;
+    }
+    CHECK(exclusive == profiler.functions.at("top(i32)").inclusive);
+
+    std::stringstream folded;
+    write_folded_stacks(folded, profiler);
+    std::vector<std::string> paths;
+    std::string path;
+    std::string nanoseconds;
+    while (folded >> path >> nanoseconds)
+    {
+        paths.push_back(path);
+    }
+    CHECK(paths == std::vector<std::string>{
+        "top(i32)", "top(i32);middle(i32)", "top(i32);middle(i32);leaf(i32)", "top(i32);leaf(i32)"
+    });
+
+    std::stringstream report;
+    print_profile(report, profiler);
+    CHECK(report.str().find("middle(i32)\n") != std::string::npos);
+}
@@ -0,0 +1,42 @@
+#include <doctest/doctest.h>
+
+#include "compiler.hpp"
+#include "parser.hpp"
+#include "program_generator.hpp"
+#include "tokenize.hpp"
+
+using namespace ant;
+
+TEST_CASE("generated programs are reproducible from their seed")
+{
+    generator_options options;
+    options.functions = 20;
+    const auto program = generate_program(options);
+    CHECK(program == generate_program(options));
+    options.seed = 2;
+    CHECK(program != generate_program(options));
+}
+
+TEST_CASE("generated programs compile and run with every fundamental type")
+{
+    generator_options options;
+    options.functions = 30;
+    options.overloads = fundamental_type_count;
+    options.depth = 8;
+    options.parameters = 5;
+    options.evaluations = 40;
+    const auto tokens = tokenize(generate_program(options));
+    const auto parsed = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_success(parsed));
+    auto [env, prog] = setup_compiler();
+    for (auto const& status : compile(prog, env, get_success(parsed).value))
+    {
+        REQUIRE(is_success(status));
+    }
+    CHECK(env.functions.at("g29").size() == fundamental_type_count);
+    REQUIRE(prog.evaluations.size() == 40);
+    for (auto& eval : prog.evaluations)
+    {
+        execute(eval);
+    }
+}
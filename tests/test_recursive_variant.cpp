@@ -2,6 +2,8 @@
 
 #include "recursive_variant.hpp"
 
+#include <utility>
+
 using namespace ant;
 
 struct recursive_struct;
@@ -70,3 +72,81 @@ TEST_CASE("visit recursive wrapper works")
     x = recursive_struct{37};
     CHECK(visit(visitor(), x) == 2);
 }
+
+TEST_CASE("recursive variants of trivial alternatives are trivial")
+{
+    using scalar_variant = recursive_variant<bool, int8_t, int32_t, double>;
+    static_assert(!std::is_polymorphic_v<scalar_variant>);
+    static_assert(std::is_standard_layout_v<scalar_variant>);
+    static_assert(std::is_trivially_copyable_v<scalar_variant>);
+    static_assert(std::is_trivially_destructible_v<scalar_variant>);
+    CHECK(sizeof(scalar_variant) == sizeof(std::variant<bool, int8_t, int32_t, double>));
+    CHECK(sizeof(recursive_variant<bool, int8_t>) == 2);
+
+    static_assert(!std::is_polymorphic_v<test_variant>);
+    static_assert(!std::is_trivially_copyable_v<test_variant>);
+}
+
+TEST_CASE("recursive variants copy and move their alternatives")
+{
+    test_variant x = recursive_struct{13};
+    test_variant y = x;
+    get<recursive_struct>(y).value = 37;
+    CHECK(get<int>(get<recursive_struct>(x).value) == 13);
+    x = y;
+    CHECK(get<int>(get<recursive_struct>(x).value) == 37);
+    test_variant z = 1;
+    z = std::move(x);
+    REQUIRE(holds<recursive_struct>(z));
+    CHECK(get<int>(get<recursive_struct>(z).value) == 37);
+}
+
+TEST_CASE("moving a recursive wrapper keeps its node")
+{
+    recursive_wrapper<int> x = 13;
+    int const* node = &x.get();
+    recursive_wrapper<int> y = std::move(x);
+    CHECK(&y.get() == node);
+    recursive_wrapper<int> z = 37;
+    z = std::move(y);
+    CHECK(&z.get() == node);
+    CHECK(z.get() == 13);
+    static_assert(std::is_nothrow_move_constructible_v<recursive_wrapper<int>>);
+}
+
+TEST_CASE("moved from recursive wrappers can be assigned values")
+{
+    recursive_wrapper<recursive_struct> x = recursive_struct{13};
+    recursive_wrapper<recursive_struct> y = std::move(x);
+    const recursive_struct value{37};
+    x = value;
+    CHECK(get<int>(x.get().value) == 37);
+    recursive_wrapper<recursive_struct> z = std::move(x);
+    x = recursive_struct{42};
+    CHECK(get<int>(x.get().value) == 42);
+    CHECK(get<int>(y.get().value) == 13);
+    CHECK(get<int>(z.get().value) == 37);
+}
+
+TEST_CASE("freed nodes of recursive wrappers are reused")
+{
+    void const* node = nullptr;
+    {
+        recursive_wrapper<recursive_struct> x = recursive_struct{13};
+        node = &x.get();
+    }
+    recursive_wrapper<recursive_struct> y = recursive_struct{37};
+    CHECK(static_cast<void const*>(&y.get()) == node);
+}
+
+TEST_CASE("copies of cow wrappers share their value until changed")
+{
+    cow_wrapper<int> x = 13;
+    cow_wrapper<int> y = x;
+    CHECK(x.shared());
+    CHECK(&std::as_const(x).get() == &std::as_const(y).get());
+    y.get() = 37;
+    CHECK(!x.shared());
+    CHECK(std::as_const(x).get() == 13);
+    CHECK(std::as_const(y).get() == 37);
+}
@@ -9,7 +9,7 @@ using namespace ant;
 
 TEST_CASE("repetition parser parses zero non-attributed tokens plus end rule")
 {
-    const std::vector<token> tokens = {{right_parenthesis_token{}}};
+    const token_stream tokens = {{right_parenthesis_token{}}};
     const auto parser = make_parser<repetition<left_parenthesis_token>>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -19,7 +19,7 @@ TEST_CASE("repetition parser parses zero non-attributed tokens plus end rule")
 
 TEST_CASE("repetition parser parses zero attributed tokens plus end rule")
 {
-    const std::vector<token> tokens = {{right_parenthesis_token{}}};
+    const token_stream tokens = {{right_parenthesis_token{}}};
     const auto parser = make_parser<repetition<identifier_token>>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -30,7 +30,7 @@ TEST_CASE("repetition parser parses zero attributed tokens plus end rule")
 
 TEST_CASE("repetition parser parses multiple non-attributed tokens")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     tokens.reserve(100);
     for (int i = 0; i < 100; ++i)
     {
@@ -55,7 +55,7 @@ TEST_CASE("repetition parser parses multiple non-attributed tokens")
 
 TEST_CASE("repetition parser parses multiple attributed tokens")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     tokens.reserve(100);
     for (int i = 0; i < 100; ++i)
     {
@@ -87,7 +87,7 @@ TEST_CASE("repetition parser parses attributed end token")
                 integer_literal_token
             >
         >();
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {identifier_token{"first"}, {}},
         {identifier_token{"second"}, {}},
@@ -115,7 +115,7 @@ TEST_CASE("repetition parser returns failure if terminal pattern is not found be
                 right_parenthesis_token
             >
         >();
-    const std::vector<token> tokens =
+    const token_stream tokens =
     {
         {left_parenthesis_token{}}
     };
@@ -132,7 +132,7 @@ TEST_CASE("repetition parser returns failure with iterator to position of failin
                 right_parenthesis_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {identifier_token{"a"}},
         {identifier_token{"b"}},
         {identifier_token{"c"}},
@@ -267,3 +267,61 @@ TEST_CASE("execute division operation with zero divisor throws exception")
     blueprint.parameters.at(1) = 0;
     REQUIRE_THROWS(execute(op));
 }
+
+TEST_CASE("execute slot operations reads operands from their slots")
+{
+    value_variant lhs = int32_t{13};
+    value_variant rhs = int32_t{37};
+    const binary_operator impl = apply_binary_operator<minus, int32_t>;
+
+    SUBCASE("for slot and slot operands")
+    {
+        slot_operation op{impl, &lhs, &rhs};
+        value_variant result = execute(op);
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == (13 - 37));
+    }
+
+    SUBCASE("for slot and constant operands")
+    {
+        slot_constant_operation op{impl, &lhs, int32_t{1}};
+        value_variant result = execute(op);
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == (13 - 1));
+    }
+
+    SUBCASE("for constant and slot operands")
+    {
+        constant_slot_operation op{impl, int32_t{1}, &rhs};
+        value_variant result = execute(op);
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == (1 - 37));
+    }
+}
+
+TEST_CASE("execute guard compares slot with constant and branches")
+{
+    value_variant slot = int32_t{0};
+    guard expr{
+        apply_binary_operator<equal_to, int32_t>,
+        &slot,
+        int32_t{0},
+        int32_t{13},
+        int32_t{37}
+    };
+
+    SUBCASE("when comparison is true")
+    {
+        value_variant result = execute(expr);
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == 13);
+    }
+
+    SUBCASE("when comparison is false")
+    {
+        slot = int32_t{1};
+        value_variant result = execute(expr);
+        REQUIRE(holds<int32_t>(result));
+        CHECK(get<int32_t>(result) == 37);
+    }
+}
@@ -7,7 +7,7 @@ using namespace ant;
 
 TEST_CASE("sequence parser parses an empty sequence")
 {
-    const std::vector<token> tokens;
+    const token_stream tokens;
     const auto parser = make_parser<sequence<>>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -17,7 +17,7 @@ TEST_CASE("sequence parser parses an empty sequence")
 
 TEST_CASE("sequence parser parses a sequence with one non-attributed token")
 {
-    const std::vector<token> tokens = { {left_parenthesis_token{}} };
+    const token_stream tokens = { {left_parenthesis_token{}} };
     const auto parser = make_parser<sequence<left_parenthesis_token>>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -27,7 +27,7 @@ TEST_CASE("sequence parser parses a sequence with one non-attributed token")
 
 TEST_CASE("sequence parser parses a sequence with one attributed token")
 {
-    const std::vector<token> tokens = { {identifier_token{"test"}} };
+    const token_stream tokens = { {identifier_token{"test"}} };
     const auto parser = make_parser<sequence<identifier_token>>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
     REQUIRE(is_success(result));
@@ -38,14 +38,14 @@ TEST_CASE("sequence parser parses a sequence with one attributed token")
 
 TEST_CASE("sequence parser throws exception on end of input for non-attributed token")
 {
-    const std::vector<token> tokens;
+    const token_stream tokens;
     const auto parser = make_parser<sequence<left_parenthesis_token>>();
     CHECK_THROWS(parser.parse(tokens.cbegin(), tokens.cend()));
 }
 
 TEST_CASE("sequence parser throws exception on end of input for attributed token")
 {
-    const std::vector<token> tokens;
+    const token_stream tokens;
     const auto parser = make_parser<sequence<identifier_token>>();
     CHECK_THROWS(parser.parse(tokens.cbegin(), tokens.cend()));
 }
@@ -59,7 +59,7 @@ TEST_CASE("sequence parser parses a sequence of non-attributed tokens")
                 right_parenthesis_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {right_parenthesis_token{}}
     };
@@ -78,7 +78,7 @@ TEST_CASE("sequence parser parses a sequence of attributed tokens")
                 integer_literal_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {identifier_token{"test"}},
         {integer_literal_token{"1337"}}
     };
@@ -102,7 +102,7 @@ TEST_CASE("sequence parser parses a sequence of mixed non-attributed and attribu
                 right_parenthesis_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {identifier_token{"test"}},
         {integer_literal_token{"1337"}},
@@ -127,7 +127,7 @@ TEST_CASE("sequence parser returns failure with iterator to position of failing
                 right_parenthesis_token
             >
         >();
-    const std::vector<token> tokens = {
+    const token_stream tokens = {
         {left_parenthesis_token{}},
         {integer_literal_token{"1337"}},
         {right_parenthesis_token{}}
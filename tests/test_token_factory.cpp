@@ -53,3 +53,22 @@ TEST_CASE("token factory creates all tokens")
         11, "abcdefghijklmnopqrstuvxz-ABCDEFGHIJKLMNOPQRSTUVXYZ_!@#$%^&*+!9+=~_0123456789");
     REQUIRE(holds<identifier_token>(identifier));
 }
+
+TEST_CASE("token dispatch creates the same tokens as the factory")
+{
+    auto factory = token_factory_builder<token_variant>::make();
+    constexpr auto dispatch = token_factory_builder<token_variant>::make_dispatch();
+    static_assert(dispatch.size() == 13);
+    CHECK(dispatch.pattern() == factory.pattern());
+    const std::vector<std::string> data = {
+        "(", ")", "[", "]", "function", "structure", "when", "let",
+        "13.37", "-1337", "false", "name"
+    };
+    for (size_t index = 0; index < data.size(); ++index)
+    {
+        const auto expected = factory.create(index, data.at(index));
+        const auto token = dispatch.create(index, data.at(index));
+        CHECK(kind_of(token) == kind_of(expected));
+        CHECK(token_text(token) == token_text(expected));
+    }
+}
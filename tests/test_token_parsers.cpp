@@ -7,7 +7,7 @@ using namespace ant;
 
 TEST_CASE("non-attributed token parser parses non attributed token")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     tokens.push_back({left_parenthesis_token{}});
     const auto parser = make_parser<left_parenthesis_token>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
@@ -17,7 +17,7 @@ TEST_CASE("non-attributed token parser parses non attributed token")
 
 TEST_CASE("non-attributed token parser returns failure on unexpected token")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     tokens.push_back({right_parenthesis_token{}});
     const auto parser = make_parser<left_parenthesis_token>();
     CHECK(is_failure(parser.parse(tokens.cbegin(), tokens.cend())));
@@ -25,14 +25,14 @@ TEST_CASE("non-attributed token parser returns failure on unexpected token")
 
 TEST_CASE("non-attributed token parser raises error on end of input")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     const auto parser = make_parser<left_parenthesis_token>();
     CHECK_THROWS(is_failure(parser.parse(tokens.cbegin(), tokens.cend())));
 }
 
 TEST_CASE("attributed token parser parses identifier token")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     tokens.push_back({identifier_token{}});
     const auto parser = make_parser<identifier_token>();
     const auto result = parser.parse(tokens.cbegin(), tokens.cend());
@@ -44,7 +44,7 @@ TEST_CASE("attributed token parser parses identifier token")
 
 TEST_CASE("attributed token parser raises error on end of input")
 {
-    std::vector<token> tokens;
+    token_stream tokens;
     const auto parser = make_parser<identifier_token>();
     CHECK_THROWS(parser.parse(tokens.cbegin(), tokens.cend()));
 }
@@ -0,0 +1,114 @@
+#include <doctest/doctest.h>
+
+#include "parser.hpp"
+#include "program_generator.hpp"
+#include "token_reader.hpp"
+#include "tokenize.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace ant;
+
+namespace
+{
+
+// Statements of the windows of a reader, parsed one window at a time.
+ast::program read_program(token_reader& reader)
+{
+    const auto parser = make_parser<ast::program>();
+    ast::program program;
+    while (reader.next())
+    {
+        auto const& window = reader.window();
+        auto result = parser.parse(window.cbegin(), window.cend());
+        REQUIRE(is_success(result));
+        for (auto& statement : get_success(result).value.statements)
+        {
+            program.statements.push_back(std::move(statement));
+        }
+    }
+    return program;
+}
+
+} // namespace
+
+TEST_CASE("token readers give windows of top-level forms")
+{
+    std::stringstream input(
+        "; a comment before the first form\n"
+        "\n"
+        "(function f i32 (i32 x)\n"
+        "  ; (unbalanced in a comment\n"
+        "  x)\n"
+        "(structure s (i32 a)) (f (i32 1))\n"
+        "\n"
+        "(f\n"
+        "  (i32 2))\n");
+    token_reader reader(input);
+
+    REQUIRE(reader.next());
+    auto const& first = reader.window();
+    CHECK(first.first_line() == 3);
+    CHECK(first.size() == 11);
+    CHECK(holds<function_token>(first.at(1)));
+    CHECK(first.at(9).context().line == 5);
+    CHECK(first.line(5) == "  x)");
+    CHECK(holds<end_of_input_token>(first.back()));
+
+    REQUIRE(reader.next());
+    CHECK(reader.window().first_line() == 6);
+    CHECK(reader.window().line_count() == 1);
+
+    REQUIRE(reader.next());
+    CHECK(reader.window().first_line() == 8);
+    CHECK(reader.window().at(3).text() == "i32");
+    CHECK(reader.window().at(3).context().line == 9);
+    CHECK(reader.window().at(3).context().offset == 4);
+
+    CHECK(!reader.next());
+    CHECK(reader.lines() == 9);
+    CHECK(reader.window().empty());
+}
+
+TEST_CASE("token readers parse programs with the tokens of a statement at a time")
+{
+    generator_options options;
+    options.functions = 50;
+    const std::string source = generate_program(options);
+    const auto tokens = tokenize(source);
+    const auto parsed = make_parser<ast::program>().parse(tokens.cbegin(), tokens.cend());
+    REQUIRE(is_success(parsed));
+    auto const& expected = get_success(parsed).value.statements;
+
+    std::stringstream input(source);
+    token_reader reader(input);
+    const auto program = read_program(reader);
+
+    REQUIRE(program.statements.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        CHECK(program.statements.at(i).storage.index() == expected.at(i).storage.index());
+        CHECK(get_context(program.statements.at(i)).line == get_context(expected.at(i)).line);
+    }
+    CHECK(reader.peak_tokens() * 10 < tokens.size());
+}
+
+TEST_CASE("token readers report failures at the lines of the source")
+{
+    std::stringstream input("(f (i32 1))\n\n(function f i32 (i32 x)\n  (x y z)\n  ]\n");
+    token_reader reader(input);
+    const auto parser = make_parser<ast::program>();
+
+    REQUIRE(reader.next());
+    CHECK(is_success(parser.parse(reader.window().cbegin(), reader.window().cend())));
+
+    REQUIRE(reader.next());
+    auto const& window = reader.window();
+    const auto result = parser.parse(window.cbegin(), window.cend());
+    REQUIRE(is_failure(result));
+    const auto line = get_failure(result).position->context().line;
+    CHECK(line >= 3);
+    CHECK(line <= 5);
+    CHECK(window.line(line).size() > 0);
+}
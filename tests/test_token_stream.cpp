@@ -0,0 +1,58 @@
+#include <doctest/doctest.h>
+
+#include "tokenize.hpp"
+
+using namespace ant;
+
+TEST_CASE("token streams store the kinds and texts of tokens")
+{
+    const auto tokens = tokenize("(function f i32 (i32 x) ; f(x) = x\n  x)\n");
+
+    REQUIRE(tokens.size() == 11);
+    CHECK(holds<left_parenthesis_token>(tokens.at(0)));
+    CHECK(holds<function_token>(tokens.at(1)));
+    CHECK(holds<identifier_token>(tokens.at(2)));
+    CHECK(tokens.at(2).text() == "f");
+    CHECK(tokens.at(6).text() == "x");
+    CHECK(holds<identifier_token>(tokens.at(8)));
+    CHECK(holds<right_parenthesis_token>(tokens.at(9)));
+    CHECK(holds<end_of_input_token>(tokens.at(10)));
+    CHECK(tokens.at(10).text().empty());
+    CHECK(tokens.bytes_per_token == 9);
+}
+
+TEST_CASE("token streams compute the contexts of tokens from their lines")
+{
+    const auto tokens = tokenize("(f\n\n  (i32 13))");
+
+    REQUIRE(tokens.line_count() == 3);
+    CHECK(tokens.line(1) == "(f");
+    CHECK(tokens.line(2) == "");
+    CHECK(tokens.line(3) == "  (i32 13))");
+
+    const auto context = tokens.at(3).context();
+    CHECK(tokens.at(3).text() == "i32");
+    CHECK(context.line == 3);
+    CHECK(context.offset == 4);
+
+    const auto end = tokens.back().context();
+    CHECK(end.line == 3);
+    CHECK(end.offset == 11);
+}
+
+TEST_CASE("tokens of a stream convert back to tokens")
+{
+    const token_stream tokens = {
+        {left_parenthesis_token{}},
+        {floating_point_literal_token{"13.37"}},
+        {scope_token{}}
+    };
+
+    CHECK(tokens.source() == "( 13.37 let");
+    const auto literal = tokens.at(1).to_token();
+    REQUIRE(holds<floating_point_literal_token>(literal.variant));
+    CHECK(get<floating_point_literal_token>(literal.variant).value == "13.37");
+    CHECK(literal.context.line == 1);
+    CHECK(literal.context.offset == 3);
+    CHECK(holds<scope_token>(tokens.at(2).to_token().variant));
+}
@@ -0,0 +1,141 @@
+#include <doctest/doctest.h>
+
+#include "pre_processing.hpp"
+#include "tokenize.hpp"
+#include "tokenizer.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace ant;
+
+namespace
+{
+
+// Tokens found by the tokenizer on every line of the source without its
+// comment.
+std::vector<token> tokenize_lines(std::string const& source)
+{
+    const tokenizer tokenizer;
+    std::stringstream stream(source);
+    std::vector<token> tokens;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(stream, line))
+    {
+        line_number += 1;
+        for (auto token : tokenizer.tokenize(remove_comments(line)))
+        {
+            token.context.line = line_number;
+            tokens.push_back(std::move(token));
+        }
+    }
+    return tokens;
+}
+
+} // namespace
+
+TEST_CASE("tokenize finds the tokens of the tokenizer on every line")
+{
+    const std::vector<std::string> sources = {
+        "",
+        "\n\n",
+        "(function fib i32 (i32 n)\n  (when [(< n (i32 2)) n] ; base case\n    (+ (fib (- n (i32 1))) (fib (- n (i32 2))))))\n",
+        "letter whenever functional structures truest false1",
+        "1.5 -2.25 +3 -x 1. 1.2.3 .5 +. 12abc",
+        "a;b\n;only a comment\nc ; d (e)\n\n  [x]",
+        "tab\there x\r\n(y)",
+        "((([[]]))) ;",
+    };
+    for (auto const& source : sources)
+    {
+        const auto expected = tokenize_lines(source);
+        const auto tokens = tokenize(source);
+        REQUIRE(tokens.size() == expected.size() + 1);
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CHECK(tokens.at(i).kind() == kind_of(expected.at(i).variant));
+            CHECK(tokens.at(i).text() == token_text(expected.at(i).variant));
+            CHECK(tokens.at(i).context().line == expected.at(i).context.line);
+            CHECK(tokens.at(i).context().offset == expected.at(i).context.offset);
+        }
+        CHECK(holds<end_of_input_token>(tokens.back()));
+    }
+}
+
+TEST_CASE("delimiter bitmaps find the delimiters with every instruction set")
+{
+    std::string source;
+    for (int i = 0; i < 40; ++i)
+    {
+        source += "(function long-identifier-" + std::to_string(i) + " [x;y]\n";
+    }
+    for (auto isa : {scan_isa::scalar, scan_isa::sse2, scan_isa::avx2})
+    {
+        if (!is_supported(isa))
+        {
+            continue;
+        }
+        const delimiter_bitmap delimiters(source, isa);
+        size_t next = source.size();
+        for (size_t i = source.size(); i-- > 0;)
+        {
+            CHECK(delimiters.is_delimiter(i) == is_delimiter(source[i]));
+            if (is_delimiter(source[i]))
+            {
+                next = i;
+            }
+            CHECK(delimiters.next_delimiter(i) == next);
+        }
+    }
+}
+
+TEST_CASE("tokenize finds the same tokens with every instruction set")
+{
+    std::string source;
+    for (int i = 0; i < 100; ++i)
+    {
+        source += "(function f" + std::to_string(i) + " i32 (i32 n) ; comment " + std::to_string(i) +
+                  "\n  (when [(< n (i32 -2)) n] (f64 1.5) a-rather-long-identifier-name))\n";
+    }
+    const auto expected = tokenize(source, scan_isa::scalar);
+    for (auto isa : {scan_isa::sse2, scan_isa::avx2})
+    {
+        if (!is_supported(isa))
+        {
+            continue;
+        }
+        const auto tokens = tokenize(source, isa);
+        REQUIRE(tokens.size() == expected.size());
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            CHECK(tokens.at(i).kind() == expected.at(i).kind());
+            CHECK(tokens.at(i).text() == expected.at(i).text());
+        }
+    }
+}
+
+TEST_CASE("tokenize finds the same tokens on several threads")
+{
+    std::string source;
+    for (int i = 0; source.size() < 600000; ++i)
+    {
+        source += "(function f" + std::to_string(i) + " i32 (i32 n) ; (comment " + std::to_string(i) +
+                  "\n  (when [(< n (i32 -2)) n]\n\n    (f64 1.5) ident))\n";
+    }
+    const auto expected = tokenize(source, scan_isa::scalar);
+    for (size_t threads : {2, 3, 8})
+    {
+        const auto tokens = tokenize(source, best_scan_isa(), threads);
+        REQUIRE(tokens.size() == expected.size());
+        REQUIRE(tokens.line_count() == expected.line_count());
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            CHECK(tokens.at(i).kind() == expected.at(i).kind());
+            CHECK(tokens.offset(i) == expected.offset(i));
+            CHECK(tokens.at(i).text() == expected.at(i).text());
+        }
+        CHECK(tokens.back().context().line == expected.back().context().line);
+        CHECK(tokens.line(tokens.line_count()) == expected.line(expected.line_count()));
+    }
+}
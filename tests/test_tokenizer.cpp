@@ -38,3 +38,35 @@ TEST_CASE("tokenizer tokenizes simple string with some tokens")
     REQUIRE(holds<floating_point_literal_token>(tokens.at(10).variant));
     CHECK(get<floating_point_literal_token>(tokens.at(10).variant).value == "-13.37");
 }
+
+TEST_CASE("tokenizer with a factory tokenizes like the default tokenizer")
+{
+    constexpr auto string = "(let [x (i32 -1)] when) 13.37 true";
+    const tokenizer default_tokenizer;
+    const tokenizer factory_tokenizer(token_factory_builder<token_variant>::make());
+    const auto expected = default_tokenizer.tokenize(string);
+    const auto tokens = factory_tokenizer.tokenize(string);
+
+    REQUIRE(tokens.size() == expected.size());
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        CHECK(kind_of(tokens.at(i).variant) == kind_of(expected.at(i).variant));
+        CHECK(token_text(tokens.at(i).variant) == token_text(expected.at(i).variant));
+        CHECK(tokens.at(i).context.offset == expected.at(i).context.offset);
+    }
+}
+
+TEST_CASE("tokenizer appends the tokens of a line to a stream")
+{
+    token_stream tokens("(f x)\n  (g 13)");
+    const tokenizer tokenizer;
+    tokenizer.tokenize(tokens.line(2), tokens.line_start(2), tokens);
+
+    REQUIRE(tokens.size() == 4);
+    CHECK(holds<left_parenthesis_token>(tokens.at(0)));
+    CHECK(tokens.at(1).text() == "g");
+    CHECK(holds<integer_literal_token>(tokens.at(2)));
+    CHECK(tokens.at(2).text() == "13");
+    CHECK(tokens.at(2).context().line == 2);
+    CHECK(tokens.at(2).context().offset == 6);
+}